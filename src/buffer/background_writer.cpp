@@ -0,0 +1,45 @@
+#include "buffer/background_writer.h"
+
+#include "buffer/buffer_pool_manager.h"
+#include "glog/logging.h"
+
+BackgroundWriter::BackgroundWriter(BufferPoolManager *buffer_pool_manager, const BackgroundWriterOptions &options)
+    : buffer_pool_manager_(buffer_pool_manager), options_(options) {
+  thread_ = std::thread(&BackgroundWriter::Run, this);
+}
+
+BackgroundWriter::~BackgroundWriter() {
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+BackgroundWriterStats BackgroundWriter::GetStats() const {
+  BackgroundWriterStats stats;
+  stats.rounds_ = rounds_.load(std::memory_order_relaxed);
+  stats.pages_written_ = pages_written_.load(std::memory_order_relaxed);
+  stats.checkpoints_ = checkpoints_.load(std::memory_order_relaxed);
+  stats.checkpoint_pages_written_ = checkpoint_pages_written_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void BackgroundWriter::Run() {
+  auto last_checkpoint = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(latch_);
+  while (!cv_.wait_for(lock, std::chrono::milliseconds(options_.interval_ms_), [this] { return stop_; })) {
+    lock.unlock();
+    pages_written_ += buffer_pool_manager_->FlushDirtyPages(options_.clean_target_, options_.max_pages_per_round_);
+    rounds_++;
+    auto now = std::chrono::steady_clock::now();
+    if (options_.checkpoint_interval_ms_ > 0 &&
+        now - last_checkpoint >= std::chrono::milliseconds(options_.checkpoint_interval_ms_)) {
+      checkpoint_pages_written_ += buffer_pool_manager_->Checkpoint();
+      checkpoints_++;
+      last_checkpoint = now;
+    }
+    lock.lock();
+  }
+}
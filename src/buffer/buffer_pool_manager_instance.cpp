@@ -0,0 +1,440 @@
+#include "buffer/buffer_pool_manager_instance.h"
+
+#include <algorithm>
+
+#include "glog/logging.h"
+
+BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, DiskScheduler *disk_scheduler,
+                                                     ReplacerType replacer_type)
+    : pool_size_(pool_size), disk_scheduler_(disk_scheduler) {
+  if (disk_scheduler_->GetDiskManager()->IsMemoryMapped()) {
+    mapped_disk_manager_ = disk_scheduler_->GetDiskManager();
+  } else {
+    frames_ = new char[pool_size_ * PAGE_SIZE]();
+  }
+  pages_ = static_cast<Page *>(::operator new[](pool_size_ * sizeof(Page)));
+  for (size_t i = 0; i < pool_size_; i++) {
+    new (pages_ + i) Page(frames_ == nullptr ? nullptr : frames_ + i * PAGE_SIZE);
+  }
+  switch (replacer_type) {
+    case ReplacerType::kClockReplacer:
+      replacer_ = new CLOCKReplacer(pool_size_);
+      break;
+    case ReplacerType::kLRUKReplacer:
+      replacer_ = new LRUKReplacer(pool_size_);
+      break;
+    default:
+      replacer_ = new LRUReplacer(pool_size_);
+  }
+  for (size_t i = 0; i < pool_size_; i++) {
+    free_list_.emplace_back(i);
+  }
+}
+
+BufferPoolManagerInstance::~BufferPoolManagerInstance() {
+  for (auto &prefetch : prefetching_) {
+    prefetch.second.wait();
+  }
+  FlushAllPages();
+  for (size_t i = 0; i < pool_size_; i++) {
+    pages_[i].~Page();
+  }
+  ::operator delete[](pages_);
+  delete[] frames_;
+  delete replacer_;
+}
+
+/**
+ * 1.     Search the page table for the requested page (P).
+ * 1.1    If P exists, pin it and return it immediately.
+ * 1.2    If P does not exist, find a replacement page (R) from either the free list or the replacer.
+ *        Note that pages are always found from the free list first.
+ * 2.     If R is dirty, write it back to the disk.
+ * 3.     Delete R from the page table and insert P.
+ * 4.     Update P's metadata, read in the page content from disk, and then return a pointer to P.
+ *        The write-back of R and the read of P are both in flight at the same time. In memory mapped mode P is
+ *        pointed at the mapping instead of read.
+ * 5.     If P fails its checksum, drop it again and return nullptr.
+ */
+Page *BufferPoolManagerInstance::FetchPage(page_id_t page_id, BufferRing *ring) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  auto i = page_table_.find(page_id);
+  if (i != page_table_.end()) {
+    if (!WaitForPrefetch(page_id)) {
+      return nullptr;
+    }
+    CountFetch(true);
+    replacer_->Pin(i->second);
+    replacer_->RecordAccess(i->second);
+    pages_[i->second].pin_count_++;
+    return pages_ + i->second;
+  }
+  frame_id_t frame_id = ring == nullptr ? INVALID_FRAME_ID : TryToReuseRingFrame(ring);
+  if (frame_id == INVALID_FRAME_ID) {
+    frame_id = TryToFindFreePage();
+  }
+  if (frame_id == INVALID_FRAME_ID) {
+//    LOG(ERROR) << "BufferPoolManagerInstance::FetchPage() crashed!" << std::endl;
+    return nullptr;
+  }
+  CountFetch(false);
+  auto write_back = WriteBackVictim(frame_id);
+  std::future<bool> read;
+  bool verified = true;
+  if (mapped_disk_manager_ != nullptr) {
+    MapFrame(frame_id, page_id);
+    verified = mapped_disk_manager_->VerifyMappedPage(page_id);
+  } else {
+    read = disk_scheduler_->ScheduleRead(page_id, pages_[frame_id].data_);
+  }
+  pages_[frame_id].is_dirty_ = false;
+  pages_[frame_id].pin_count_ = 1;
+  pages_[frame_id].page_id_ = page_id;
+  page_table_[page_id] = frame_id;
+  replacer_->RecordAccess(frame_id);
+  if (ring != nullptr) {
+    ring->frames_.emplace_back(frame_id, page_id);
+  }
+  if (read.valid()) {
+    verified = read.get();
+  }
+  if (write_back.valid()) {
+    write_back.get();
+  }
+  if (!verified) {
+    DiscardFrame(frame_id);
+    return nullptr;
+  }
+  return pages_ + frame_id;
+}
+
+/**
+ * 1.   If all the pages in this instance are pinned, return nullptr.
+ * 2.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
+ * 3.   Update P's metadata, zero out memory and add P to the page table.
+ */
+Page *BufferPoolManagerInstance::NewPage(page_id_t page_id) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  ReapPrefetches();
+  // a speculative read-ahead may have brought in the page before it was allocated
+  if (page_table_.count(page_id) > 0 && !DeletePage(page_id)) {
+    return nullptr;
+  }
+  if (replacer_->Size() + free_list_.size() == 0) {
+//    LOG(INFO) << "BufferPoolManagerInstance::NewPage() failed: Buffer is completely filled!" << std::endl;
+    return nullptr;
+  }
+  frame_id_t frame_id = TryToFindFreePage();
+  if (frame_id == INVALID_FRAME_ID) {
+    return nullptr;
+  }
+  StatsAdd(new_pages_);
+  auto write_back = WriteBackVictim(frame_id);
+  MapFrame(frame_id, page_id);
+  memset(pages_[frame_id].data_, 0, PAGE_SIZE);
+  pages_[frame_id].pin_count_ = 1;
+  pages_[frame_id].is_dirty_ = true;
+  pages_[frame_id].page_id_ = page_id;
+  page_table_[page_id] = frame_id;
+  replacer_->RecordAccess(frame_id);
+  replacer_->Unpin(frame_id);
+  replacer_->Pin(frame_id);
+  if (write_back.valid()) {
+    write_back.get();
+  }
+  return pages_ + frame_id;
+}
+
+/**
+ * 1.   Search the page table for the requested page (P).
+ * 1.   If P does not exist, return true.
+ * 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
+ * 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
+ */
+bool BufferPoolManagerInstance::DeletePage(page_id_t page_id) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  auto i = page_table_.find(page_id);
+  if (i == page_table_.end()) {
+    return true;
+  }
+  frame_id_t frame_id = i->second;
+  if (!WaitForPrefetch(page_id)) {
+    return true;
+  }
+  if (pages_[frame_id].pin_count_ > 0) {
+//    LOG(INFO) << "BufferPoolManagerInstance::DeletePage() failed: " << "Page " << page_id << " is pinned." << std::endl;
+    return false;
+  }
+  if (pages_[frame_id].is_dirty_) {
+    disk_scheduler_->ScheduleWrite(page_id, pages_[frame_id].data_).get();
+  }
+  if (mapped_disk_manager_ != nullptr) {
+    mapped_disk_manager_->ReleaseMappedPage(page_id);
+  }
+  DiscardFrame(frame_id);
+  return true;
+}
+
+bool BufferPoolManagerInstance::UnpinPage(page_id_t page_id, bool is_dirty) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  auto i = page_table_.find(page_id);
+  if (i == page_table_.end()) {
+//    LOG(INFO) << "BufferPoolManagerInstance::UnpinPage() failed: Page " << page_id << " not found." << std::endl;
+    return false;
+  }
+  Page &page = pages_[i->second];
+  if (is_dirty) {
+    page.is_dirty_ = true;
+  }
+  if (page.pin_count_ > 0 && --page.pin_count_ == 0) {
+    replacer_->Unpin(i->second);
+  }
+  return true;
+}
+
+bool BufferPoolManagerInstance::FlushPage(page_id_t page_id) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  auto i = page_table_.find(page_id);
+  if (i == page_table_.end()) {
+//    LOG(INFO) << "BufferPoolManagerInstance::FlushPage() failed: Page " << page_id << " not found." << std::endl;
+    return false;
+  }
+  // never stamp a fresh checksum on a page which failed its own
+  if (!WaitForPrefetch(page_id)) {
+    return false;
+  }
+  disk_scheduler_->ScheduleWrite(i->first, pages_[i->second].data_).get();
+  StatsAdd(pages_flushed_);
+  pages_[i->second].is_dirty_ = false;
+  return true;
+}
+
+bool BufferPoolManagerInstance::Prefetch(page_id_t page_id, BufferRing *ring) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  if (mapped_disk_manager_ != nullptr) {
+    // the kernel pages the mapping in, no frame needs to be spent on the page
+    if (page_table_.count(page_id) == 0) {
+      mapped_disk_manager_->PrefetchMappedPage(page_id);
+      StatsAdd(prefetches_);
+    }
+    return false;
+  }
+  ReapPrefetches();
+  // keep most of the frames for pages somebody actually asked for
+  if (page_table_.count(page_id) > 0 || prefetching_.size() >= max<size_t>(1, pool_size_ / 4)) {
+    return false;
+  }
+  frame_id_t frame_id = ring == nullptr ? INVALID_FRAME_ID : TryToReuseRingFrame(ring);
+  if (frame_id == INVALID_FRAME_ID) {
+    frame_id = TryToFindFreePage();
+  }
+  if (frame_id == INVALID_FRAME_ID) {
+    return false;
+  }
+  // the write back buffer is reused by the next victim, so the write has to finish first
+  auto write_back = WriteBackVictim(frame_id);
+  if (write_back.valid()) {
+    write_back.get();
+  }
+  pages_[frame_id].is_dirty_ = false;
+  pages_[frame_id].pin_count_ = 0;
+  pages_[frame_id].page_id_ = page_id;
+  page_table_[page_id] = frame_id;
+  if (ring != nullptr) {
+    ring->frames_.emplace_back(frame_id, page_id);
+  }
+  prefetching_.emplace(page_id, disk_scheduler_->ScheduleRead(page_id, pages_[frame_id].data_));
+  StatsAdd(prefetches_);
+  return true;
+}
+
+size_t BufferPoolManagerInstance::FlushDirtyPages(double clean_target, size_t max_pages) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  size_t clean = free_list_.size();
+  vector<frame_id_t> dirty;
+  for (size_t i = 0; i < pool_size_; i++) {
+    if (pages_[i].page_id_ == INVALID_PAGE_ID || pages_[i].pin_count_ > 0) {
+      continue;
+    }
+    if (pages_[i].is_dirty_) {
+      dirty.push_back(i);
+    } else {
+      clean++;
+    }
+  }
+  auto target = static_cast<size_t>(clean_target * pool_size_);
+  if (clean >= target || dirty.empty()) {
+    return 0;
+  }
+  sort(dirty.begin(), dirty.end(),
+       [this](frame_id_t a, frame_id_t b) { return pages_[a].page_id_ < pages_[b].page_id_; });
+  dirty.resize(min({dirty.size(), target - clean, max_pages}));
+  FlushFrames(dirty);
+  return dirty.size();
+}
+
+size_t BufferPoolManagerInstance::FlushAllPages(bool include_pinned) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  vector<frame_id_t> dirty;
+  for (size_t i = 0; i < pool_size_; i++) {
+    if (!include_pinned && pages_[i].pin_count_ > 0) {
+      continue;
+    }
+    if (pages_[i].page_id_ != INVALID_PAGE_ID && pages_[i].is_dirty_) {
+      dirty.push_back(i);
+    }
+  }
+  FlushFrames(dirty);
+  return dirty.size();
+}
+
+BufferPoolStats BufferPoolManagerInstance::GetStats() const {
+  BufferPoolStats stats;
+  stats.fetch_hits_ = fetch_hits_.load(std::memory_order_relaxed);
+  stats.fetch_misses_ = fetch_misses_.load(std::memory_order_relaxed);
+  stats.new_pages_ = new_pages_.load(std::memory_order_relaxed);
+  stats.evictions_ = evictions_.load(std::memory_order_relaxed);
+  stats.dirty_write_backs_ = dirty_write_backs_.load(std::memory_order_relaxed);
+  stats.pages_flushed_ = pages_flushed_.load(std::memory_order_relaxed);
+  stats.prefetches_ = prefetches_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+// Only used for debug
+bool BufferPoolManagerInstance::CheckAllUnpinned() {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  bool res = true;
+  for (size_t i = 0; i < pool_size_; i++) {
+    if (pages_[i].pin_count_ != 0) {
+      res = false;
+//      LOG(ERROR) << "page " << pages_[i].page_id_ << " pin count:" << pages_[i].pin_count_ << endl;
+    }
+  }
+  return res;
+}
+
+frame_id_t BufferPoolManagerInstance::TryToFindFreePage() {
+  frame_id_t frame_id;
+  if (free_list_.empty() && replacer_->Size() == 0) {
+    ReapPrefetches();
+  }
+  if (free_list_.empty()) {
+    if (!replacer_->Victim(&frame_id)) {
+      return INVALID_FRAME_ID;
+    }
+    page_table_.erase(pages_[frame_id].page_id_);
+    StatsAdd(evictions_);
+  } else {
+    frame_id = free_list_.front();
+    free_list_.pop_front();
+  }
+  return frame_id;
+}
+
+frame_id_t BufferPoolManagerInstance::TryToReuseRingFrame(BufferRing *ring) {
+  if (ring->frames_.size() < ring->capacity_) {
+    return INVALID_FRAME_ID;
+  }
+  auto [frame_id, page_id] = ring->frames_.front();
+  ring->frames_.pop_front();
+  // the frame may have been victimized and refilled meanwhile, or someone else may be using the page
+  if (pages_[frame_id].page_id_ != page_id || pages_[frame_id].pin_count_ > 0) {
+    return INVALID_FRAME_ID;
+  }
+  // a page which failed its checksum went to the free list, where the caller finds the frame next
+  if (!WaitForPrefetch(page_id)) {
+    return INVALID_FRAME_ID;
+  }
+  replacer_->Remove(frame_id);
+  page_table_.erase(page_id);
+  StatsAdd(evictions_);
+  return frame_id;
+}
+
+void BufferPoolManagerInstance::CountFetch(bool hit) {
+  StatsAdd(hit ? fetch_hits_ : fetch_misses_);
+  auto *stats = StatsScope::Current();
+  if (stats != nullptr) {
+    StatsAdd(hit ? stats->fetch_hits_ : stats->fetch_misses_);
+  }
+}
+
+bool BufferPoolManagerInstance::WaitForPrefetch(page_id_t page_id) {
+  auto i = prefetching_.find(page_id);
+  if (i == prefetching_.end()) {
+    return true;
+  }
+  bool verified = i->second.get();
+  prefetching_.erase(i);
+  if (!verified) {
+    DiscardFrame(page_table_[page_id]);
+  }
+  return verified;
+}
+
+void BufferPoolManagerInstance::ReapPrefetches() {
+  for (auto i = prefetching_.begin(); i != prefetching_.end();) {
+    if (i->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      ++i;
+      continue;
+    }
+    if (i->second.get()) {
+      replacer_->Unpin(page_table_[i->first]);
+    } else {
+      DiscardFrame(page_table_[i->first]);
+    }
+    i = prefetching_.erase(i);
+  }
+}
+
+void BufferPoolManagerInstance::DiscardFrame(frame_id_t frame_id) {
+  // take the frame away from the replacer before handing it back to the free list
+  replacer_->Remove(frame_id);
+  page_table_.erase(pages_[frame_id].page_id_);
+  pages_[frame_id].page_id_ = INVALID_PAGE_ID;
+  pages_[frame_id].is_dirty_ = false;
+  pages_[frame_id].pin_count_ = 0;
+  free_list_.push_back(frame_id);
+}
+
+void BufferPoolManagerInstance::FlushFrames(vector<frame_id_t> &frame_ids) {
+  sort(frame_ids.begin(), frame_ids.end(),
+       [this](frame_id_t a, frame_id_t b) { return pages_[a].page_id_ < pages_[b].page_id_; });
+  vector<std::future<bool>> writes;
+  writes.reserve(frame_ids.size());
+  for (auto frame_id : frame_ids) {
+    writes.emplace_back(disk_scheduler_->ScheduleWrite(pages_[frame_id].page_id_, pages_[frame_id].data_));
+  }
+  StatsAdd(pages_flushed_, frame_ids.size());
+  for (size_t i = 0; i < frame_ids.size(); i++) {
+    writes[i].get();
+    if (pages_[frame_ids[i]].pin_count_ == 0) {
+      pages_[frame_ids[i]].is_dirty_ = false;
+    }
+  }
+}
+
+std::future<bool> BufferPoolManagerInstance::WriteBackVictim(frame_id_t frame_id) {
+  Page &page = pages_[frame_id];
+  if (mapped_disk_manager_ != nullptr && page.page_id_ != INVALID_PAGE_ID) {
+    // the frame is repointed rather than overwritten, so the page is written in place and no copy is needed
+    if (page.is_dirty_) {
+      StatsAdd(dirty_write_backs_);
+      disk_scheduler_->ScheduleWrite(page.page_id_, page.data_).get();
+    }
+    mapped_disk_manager_->ReleaseMappedPage(page.page_id_);
+    return {};
+  }
+  if (!page.is_dirty_) {
+    return {};
+  }
+  StatsAdd(dirty_write_backs_);
+  memcpy(write_back_buffer_, page.data_, PAGE_SIZE);
+  return disk_scheduler_->ScheduleWrite(page.page_id_, write_back_buffer_);
+}
+
+void BufferPoolManagerInstance::MapFrame(frame_id_t frame_id, page_id_t page_id) {
+  if (mapped_disk_manager_ != nullptr) {
+    pages_[frame_id].data_ = mapped_disk_manager_->GetMappedPage(page_id);
+  }
+}
@@ -21,7 +21,7 @@ bool CLOCKReplacer::Victim(frame_id_t *frame_id) {
         *frame_id = *clock_pointer;
         clock_status.erase(*clock_pointer);
         *clock_pointer = INVALID_FRAME_ID;
-        LOG(INFO) << "CLOCKReplacer::Victim() succeeded: Frame " << *frame_id << " victimized." << std::endl;
+//        LOG(INFO) << "CLOCKReplacer::Victim() succeeded: Frame " << *frame_id << " victimized." << std::endl;
         return true;
       }
     }
@@ -30,23 +30,23 @@ bool CLOCKReplacer::Victim(frame_id_t *frame_id) {
       clock_pointer = clock_list.begin();
   }
   *frame_id = INVALID_FRAME_ID;
-  LOG(INFO) << "CLOCKReplacer::Victim() failed: No frame can be victimized!" << std::endl;
+//  LOG(INFO) << "CLOCKReplacer::Victim() failed: No frame can be victimized!" << std::endl;
   return false;
 }
 
 void CLOCKReplacer::Pin(frame_id_t frame_id) {
   if (clock_status.count(frame_id)) {
     clock_status[frame_id] = 2;
-    LOG(INFO) << "CLOCKReplacer::Pin() succeeded: Frame " << frame_id << " is pinned." << std::endl;
+//    LOG(INFO) << "CLOCKReplacer::Pin() succeeded: Frame " << frame_id << " is pinned." << std::endl;
   }
-  else
-    LOG(INFO) << "CLOCKReplacer::Pin() failed: Frame " << frame_id << " is not found." << std::endl;
+//  else
+//    LOG(INFO) << "CLOCKReplacer::Pin() failed: Frame " << frame_id << " is not found." << std::endl;
 }
 
 void CLOCKReplacer::Unpin(frame_id_t frame_id) {
   if (clock_status.count(frame_id)) {
     clock_status[frame_id] = 1;
-    LOG(INFO) << "CLOCKReplacer::Unpin() succeeded: Frame " << frame_id << "is set to unpinned." << std::endl;
+//    LOG(INFO) << "CLOCKReplacer::Unpin() succeeded: Frame " << frame_id << "is set to unpinned." << std::endl;
   }
   else {
     for (size_t i = 0; i < capacity; ++i) {
@@ -56,7 +56,7 @@ void CLOCKReplacer::Unpin(frame_id_t frame_id) {
       if (clock_pointer == clock_list.end())
         clock_pointer = clock_list.begin();
       if (i == capacity - 1) {
-        LOG(INFO) << "CLOCKReplacer::Unpin() failed: No frame available!" << std::endl;
+//        LOG(INFO) << "CLOCKReplacer::Unpin() failed: No frame available!" << std::endl;
         return ;
       }
     }
@@ -65,12 +65,12 @@ void CLOCKReplacer::Unpin(frame_id_t frame_id) {
       clock_status[frame_id] = 1;
     }
     else {
-      LOG(INFO) << "CLOCKReplacer::Unpin() failed: No frame available!" << std::endl;
+//      LOG(INFO) << "CLOCKReplacer::Unpin() failed: No frame available!" << std::endl;
     }
     clock_pointer++;
     if (clock_pointer == clock_list.end())
       clock_pointer = clock_list.begin();
-    LOG(INFO) << "CLOCKReplacer::Unpin() succeeded: " << "Frame " << frame_id << " is pushed into the buffer." << std::endl;
+//    LOG(INFO) << "CLOCKReplacer::Unpin() succeeded: " << "Frame " << frame_id << " is pushed into the buffer." << std::endl;
   }
 }
 
@@ -0,0 +1,76 @@
+#include "buffer/lru_k_replacer.h"
+
+#include "glog/logging.h"
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k) : max_num_pages_(num_pages), k_(k) {
+  ASSERT(k_ > 0, "K must be positive.");
+  frames_.reserve(max_num_pages_);
+}
+
+LRUKReplacer::~LRUKReplacer() = default;
+
+bool LRUKReplacer::Victim(frame_id_t *frame_id) {
+  if (evictable_.empty()) {
+//    LOG(INFO) << "LRUKReplacer::Victim() failed: No victim found." << std::endl;
+    *frame_id = INVALID_FRAME_ID;
+    return false;
+  }
+  *frame_id = std::get<2>(*evictable_.begin());
+  evictable_.erase(evictable_.begin());
+  frames_.erase(*frame_id);
+  return true;
+}
+
+void LRUKReplacer::Pin(frame_id_t frame_id) {
+  auto i = frames_.find(frame_id);
+  if (i == frames_.end() || !i->second.evictable_) {
+    return;
+  }
+  evictable_.erase(MakeKey(frame_id, i->second));
+  i->second.evictable_ = false;
+}
+
+/**
+ * A frame unpinned without any recorded access counts as accessed now, so the replacer also works for callers which
+ * never call RecordAccess().
+ */
+void LRUKReplacer::Unpin(frame_id_t frame_id) {
+  auto &entry = frames_[frame_id];
+  if (entry.evictable_) {
+    return;
+  }
+  if (entry.history_.empty()) {
+    entry.history_.push_back(current_timestamp_++);
+  }
+  entry.evictable_ = true;
+  evictable_.insert(MakeKey(frame_id, entry));
+}
+
+size_t LRUKReplacer::Size() {
+  return evictable_.size();
+}
+
+void LRUKReplacer::RecordAccess(frame_id_t frame_id) {
+  auto &entry = frames_[frame_id];
+  if (entry.evictable_) {
+    evictable_.erase(MakeKey(frame_id, entry));
+  }
+  entry.history_.push_back(current_timestamp_++);
+  if (entry.history_.size() > k_) {
+    entry.history_.pop_front();
+  }
+  if (entry.evictable_) {
+    evictable_.insert(MakeKey(frame_id, entry));
+  }
+}
+
+void LRUKReplacer::Remove(frame_id_t frame_id) {
+  auto i = frames_.find(frame_id);
+  if (i == frames_.end()) {
+    return;
+  }
+  if (i->second.evictable_) {
+    evictable_.erase(MakeKey(frame_id, i->second));
+  }
+  frames_.erase(i);
+}
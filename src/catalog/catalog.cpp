@@ -1,7 +1,7 @@
 #include "catalog/catalog.h"
 
 void CatalogMeta::SerializeTo(char *buf) const {
-  ASSERT(GetSerializedSize() <= PAGE_SIZE, "Failed to serialize catalog metadata to disk.");
+  ASSERT(GetSerializedSize() <= PAGE_USABLE_SIZE, "Failed to serialize catalog metadata to disk.");
   MACH_WRITE_UINT32(buf, CATALOG_METADATA_MAGIC_NUM);
   buf += 4;
   MACH_WRITE_UINT32(buf, table_meta_pages_.size());
@@ -78,7 +78,9 @@ CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManag
       TableMetadata *table_meta;
       TableMetadata::DeserializeFrom(table_meta_page->GetData(), table_meta);
       table_names_[table_meta->GetTableName()] = table_meta->GetTableId();
-      auto table_heap = TableHeap::Create(buffer_pool_manager, table_meta->GetFirstPageId(), table_meta->GetSchema(), log_manager_, lock_manager_);
+      auto table_heap = TableHeap::Create(buffer_pool_manager, table_meta->GetFirstPageId(),
+                                          table_meta->GetFreeSpaceMapPageId(), table_meta->GetSchema(), log_manager_,
+                                          lock_manager_, table_meta->GetLayout());
       TableInfo *table_info = TableInfo::Create();
       table_info->Init(table_meta, table_heap);
       tables_[table_meta->GetTableId()] = table_info;
@@ -120,11 +122,14 @@ CatalogManager::~CatalogManager() {
  * TODO: Student Implement
  */
 dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schema,
-                                    Transaction *txn, TableInfo *&table_info) {
+                                    Transaction *txn, TableInfo *&table_info, TableLayout layout) {
   if(table_names_.count(table_name) != 0)
   {
     return DB_TABLE_ALREADY_EXIST;
   }
+  if (layout == TableLayout::kPax && PaxPage::ComputeCapacity(schema) == 0) {
+    return DB_FAILED;
+  }
   table_id_t table_id = next_table_id_;
   table_names_.emplace(table_name, table_id);
 
@@ -132,8 +137,9 @@ dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schem
   auto table_meta_page = buffer_pool_manager_->NewPage(page_id);
   catalog_meta_->table_meta_pages_.emplace(table_id, page_id);
 
-  auto table_heap = TableHeap::Create(buffer_pool_manager_, schema, txn, log_manager_, lock_manager_);
-  auto table_meta = TableMetadata::Create(table_id, table_name, table_heap->GetFirstPageId(), schema);
+  auto table_heap = TableHeap::Create(buffer_pool_manager_, schema, txn, log_manager_, lock_manager_, layout);
+  auto table_meta = TableMetadata::Create(table_id, table_name, table_heap->GetFirstPageId(),
+                                         table_heap->GetFreeSpaceMapPageId(), schema, layout);
   table_meta->SerializeTo(table_meta_page->GetData());
   buffer_pool_manager_->UnpinPage(page_id, true);
   next_table_id_++;
@@ -207,13 +213,15 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
   index_info->Init(index_meta, table_info->second, buffer_pool_manager_);
   auto table_heap = table_info->second->GetTableHeap();
   vector<Field> f;
-  for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); it++) {
+  // backfill through a ring of frames, so scanning a large table does not evict the index pages
+  BufferAccessStrategy strategy;
+  for (auto it = table_heap->Begin(nullptr, &strategy); it != table_heap->End(); ++it) {
     f.clear();
     for (auto pos : key_map) {
       f.push_back(*(it->GetField(pos)));
     }
     Row row(f);
-    index_info->GetIndex()->InsertEntry(row, it->GetRowId(), nullptr);
+    index_info->GetIndex()->InsertEntry(row, it.GetRowId(), nullptr);
   }
   indexes_[index_id] = index_info;
   next_index_id_++;
@@ -268,10 +276,27 @@ dberr_t CatalogManager::DropTable(const string &table_name) {
   auto table_id = temp->second;
   table_names_.erase(table_name);
 
+  // the indexes go along with the table, their key schemas refer to its columns
+  auto table_indexes = index_names_.find(table_name);
+  if (table_indexes != index_names_.end()) {
+    for (auto &index : table_indexes->second) {
+      IndexInfo *index_info = indexes_[index.second];
+      index_info->GetIndex()->Destroy();
+      catalog_meta_->DeleteIndexMetaPage(buffer_pool_manager_, index.second);
+      delete index_info;
+      indexes_.erase(index.second);
+    }
+    index_names_.erase(table_indexes);
+  }
+
   page_id_t page_id = catalog_meta_->table_meta_pages_[table_id];
   catalog_meta_->table_meta_pages_.erase(table_id);
 
-  buffer_pool_manager_->DeletePage(page_id);
+  buffer_pool_manager_->FreePage(page_id);
+  // free the pages of the heap, the pages it reserved but never used are given back when it is deleted
+  TableInfo *table_info = tables_[table_id];
+  table_info->GetTableHeap()->DeleteTable();
+  delete table_info;
   tables_.erase(table_id);
   return DB_SUCCESS;
 }
@@ -327,7 +352,9 @@ dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t pag
   auto table_name = table_meta->GetTableName();
   table_names_[table_name] = table_id;
 
-  auto table_heap = TableHeap::Create(buffer_pool_manager_, page_id, table_meta->GetSchema(), log_manager_, lock_manager_);
+  auto table_heap = TableHeap::Create(buffer_pool_manager_, table_meta->GetFirstPageId(),
+                                      table_meta->GetFreeSpaceMapPageId(), table_meta->GetSchema(), log_manager_,
+                                      lock_manager_, table_meta->GetLayout());
   auto table_info = TableInfo::Create();
   table_info->Init(table_meta, table_heap);
   tables_.emplace(table_id, table_info);
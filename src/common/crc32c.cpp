@@ -0,0 +1,95 @@
+#include "common/crc32c.h"
+
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+namespace {
+
+constexpr uint32_t CRC32C_POLY = 0x82F63B78;  // reflected Castagnoli polynomial
+
+/**
+ * Lookup tables of slicing-by-8, table k advances the checksum of a byte followed by k zero bytes.
+ */
+struct Crc32cTables {
+  uint32_t table_[8][256];
+
+  constexpr Crc32cTables() : table_() {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; bit++) {
+        crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+      }
+      table_[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+      for (int k = 1; k < 8; k++) {
+        table_[k][i] = (table_[k - 1][i] >> 8) ^ table_[0][table_[k - 1][i] & 0xff];
+      }
+    }
+  }
+};
+
+constexpr Crc32cTables TABLES;
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) uint32_t Crc32cHardware(const char *data, size_t length, uint32_t crc) {
+  uint64_t crc64 = ~crc;
+  while (length >= 8) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+    data += 8;
+    length -= 8;
+  }
+  auto crc32 = static_cast<uint32_t>(crc64);
+  while (length-- > 0) {
+    crc32 = _mm_crc32_u8(crc32, static_cast<uint8_t>(*data++));
+  }
+  return ~crc32;
+}
+#endif
+
+using Crc32cFunction = uint32_t (*)(const char *, size_t, uint32_t);
+
+Crc32cFunction ChooseCrc32c() {
+#if defined(__x86_64__)
+  if (__builtin_cpu_supports("sse4.2")) {
+    return Crc32cHardware;
+  }
+#endif
+  return Crc32cSoftware;
+}
+
+}  // namespace
+
+uint32_t Crc32cSoftware(const char *data, size_t length, uint32_t crc) {
+  const auto &t = TABLES.table_;
+  auto *p = reinterpret_cast<const uint8_t *>(data);
+  crc = ~crc;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  while (length >= 8) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    word ^= crc;
+    crc = t[7][word & 0xff] ^ t[6][(word >> 8) & 0xff] ^ t[5][(word >> 16) & 0xff] ^ t[4][(word >> 24) & 0xff] ^
+          t[3][(word >> 32) & 0xff] ^ t[2][(word >> 40) & 0xff] ^ t[1][(word >> 48) & 0xff] ^ t[0][word >> 56];
+    p += 8;
+    length -= 8;
+  }
+#endif
+  while (length-- > 0) {
+    crc = t[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+uint32_t Crc32c(const char *data, size_t length, uint32_t crc) {
+  // resolved on first use, so that other static initializers may already checksum pages
+  static const Crc32cFunction function = ChooseCrc32c();
+  return function(data, length, crc);
+}
+
+bool Crc32cIsHardwareAccelerated() { return ChooseCrc32c() != Crc32cSoftware; }
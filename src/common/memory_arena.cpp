@@ -0,0 +1,57 @@
+#include "common/memory_arena.h"
+
+#include <algorithm>
+#include <cstring>
+
+void *MemoryArena::Allocate(size_t size, size_t alignment) {
+  stats_.allocations_++;
+  stats_.bytes_allocated_ += size;
+  size_t padding = (alignment - reinterpret_cast<uintptr_t>(cur_) % alignment) % alignment;
+  if (cur_ != nullptr && padding + size <= static_cast<size_t>(end_ - cur_)) {
+    char *object = cur_ + padding;
+    cur_ = object + size;
+    return object;
+  }
+  // a large object gets a block of its own, the current block keeps serving the small ones
+  if (size + alignment > block_size_ / 4) {
+    return AddBlock(size);
+  }
+  cur_ = AddBlock(block_size_);
+  end_ = cur_ + block_size_;
+  char *object = cur_;
+  cur_ += size;
+  return object;
+}
+
+char *MemoryArena::CopyChars(const char *data, size_t len) {
+  auto chars = static_cast<char *>(Allocate(len, alignof(char)));
+  memcpy(chars, data, len);
+  return chars;
+}
+
+void MemoryArena::Reset() {
+  auto regular = std::find_if(blocks_.begin(), blocks_.end(), [&](const Block &block) {
+    return block.size_ == block_size_;
+  });
+  if (regular == blocks_.end()) {
+    blocks_.clear();
+    cur_ = end_ = nullptr;
+    held_bytes_ = 0;
+    return;
+  }
+  Block kept = std::move(*regular);
+  blocks_.clear();
+  cur_ = kept.data_.get();
+  end_ = cur_ + kept.size_;
+  held_bytes_ = kept.size_;
+  blocks_.push_back(std::move(kept));
+}
+
+char *MemoryArena::AddBlock(size_t size) {
+  // new[] aligns the block for any fundamental type
+  blocks_.push_back({std::unique_ptr<char[]>(new char[size]), size});
+  stats_.blocks_++;
+  held_bytes_ += size;
+  stats_.peak_bytes_ = std::max(stats_.peak_bytes_, held_bytes_);
+  return blocks_.back().data_.get();
+}
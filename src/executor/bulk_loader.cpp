@@ -0,0 +1,242 @@
+#include "executor/bulk_loader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include "executor/index_key.h"
+
+BulkLoader::BulkLoader(ExecuteContext *exec_ctx, TableInfo *table_info)
+    : exec_ctx_(exec_ctx), table_info_(table_info) {
+  exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->GetTableName(), indexes_);
+  keys_.resize(indexes_.size());
+}
+
+size_t BulkLoader::Load(const std::string &file_name) {
+  std::ifstream file(file_name, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::string("File " + file_name + " not found!");
+  }
+  try {
+    // the records cut by the end of a chunk are moved to the front and completed by the next chunk
+    std::vector<char> buffer;
+    size_t size = 0;
+    bool eof = false;
+    while (!eof) {
+      if (buffer.size() < size + BULK_LOAD_CHUNK_SIZE) {
+        buffer.resize(size + BULK_LOAD_CHUNK_SIZE);
+      }
+      file.read(buffer.data() + size, BULK_LOAD_CHUNK_SIZE);
+      size += file.gcount();
+      if (file.bad()) {
+        throw std::string("Failed to read " + file_name + "!");
+      }
+      eof = file.eof();
+      const char *rest = ParseRecords(buffer.data(), buffer.data() + size, eof);
+      size -= rest - buffer.data();
+      memmove(buffer.data(), rest, size);
+    }
+    Flush();
+    BuildIndexes();
+  } catch (const std::string &) {
+    Rollback();
+    throw;
+  }
+  return inserted_.size();
+}
+
+const char *BulkLoader::ParseRecords(const char *begin, const char *end, bool eof) {
+  const char *record = begin;
+  while (record < end) {
+    // a line break within quotes belongs to the field
+    bool quoted = false;
+    size_t line_breaks = 0;
+    const char *record_end = record;
+    for (; record_end < end; record_end++) {
+      if (*record_end == '"') {
+        quoted = !quoted;
+      } else if (*record_end == '\n') {
+        if (!quoted) {
+          break;
+        }
+        line_breaks++;
+      }
+    }
+    if (record_end == end && !eof) {
+      return record;
+    }
+    ParseRecord(record, record_end);
+    line_no_ += line_breaks + 1;
+    record = record_end == end ? end : record_end + 1;
+  }
+  return end;
+}
+
+void BulkLoader::ParseRecord(const char *begin, const char *end) {
+  if (end > begin && end[-1] == '\r') {
+    end--;
+  }
+  if (begin == end) {
+    return;
+  }
+  uint32_t column_count = table_info_->GetSchema()->GetColumnCount();
+  std::vector<Field> fields;
+  fields.reserve(column_count);
+  const char *pos = begin;
+  while (true) {
+    if (fields.size() == column_count) {
+      throw ErrorAt("more than " + std::to_string(column_count) + " fields.");
+    }
+    if (pos < end && *pos == '"') {
+      scratch_.clear();
+      for (pos++;; pos++) {
+        if (pos == end) {
+          throw ErrorAt("unterminated quoted field.");
+        }
+        if (*pos == '"') {
+          if (pos + 1 == end || pos[1] != '"') {
+            break;
+          }
+          pos++;
+        }
+        scratch_.push_back(*pos);
+      }
+      pos++;
+      if (pos < end && *pos != ',') {
+        throw ErrorAt("unexpected character after a quoted field.");
+      }
+      AppendField(fields.size(), scratch_.data(), scratch_.size(), fields);
+    } else {
+      auto field_end = static_cast<const char *>(memchr(pos, ',', end - pos));
+      if (field_end == nullptr) {
+        field_end = end;
+      }
+      AppendField(fields.size(), field_end == pos ? nullptr : pos, field_end - pos, fields);
+      pos = field_end;
+    }
+    if (pos == end) {
+      break;
+    }
+    // skip the separator
+    pos++;
+  }
+  if (fields.size() != column_count) {
+    throw ErrorAt("expected " + std::to_string(column_count) + " fields, got " + std::to_string(fields.size()) + ".");
+  }
+  batch_.emplace_back(fields);
+  if (batch_.size() >= DEFAULT_INSERT_BATCH_SIZE) {
+    Flush();
+  }
+}
+
+void BulkLoader::AppendField(uint32_t column_index, const char *text, size_t len, std::vector<Field> &fields) {
+  const Column *column = table_info_->GetSchema()->GetColumn(column_index);
+  if (text == nullptr) {
+    if (!column->IsNullable()) {
+      throw ErrorAt("column " + column->GetName() + " cannot be NULL.");
+    }
+    fields.emplace_back(column->GetType());
+    return;
+  }
+  switch (column->GetType()) {
+    case TypeId::kTypeInt: {
+      std::string number(text, len);
+      char *number_end;
+      errno = 0;
+      long value = strtol(number.c_str(), &number_end, 10);
+      if (number.empty() || *number_end != '\0' || errno == ERANGE || value < INT_MIN || value > INT_MAX) {
+        throw ErrorAt("invalid int \"" + number + "\" for column " + column->GetName() + ".");
+      }
+      fields.emplace_back(TypeId::kTypeInt, static_cast<int32_t>(value));
+      break;
+    }
+    case TypeId::kTypeFloat: {
+      std::string number(text, len);
+      char *number_end;
+      errno = 0;
+      float value = strtof(number.c_str(), &number_end);
+      if (number.empty() || *number_end != '\0' || errno == ERANGE) {
+        throw ErrorAt("invalid float \"" + number + "\" for column " + column->GetName() + ".");
+      }
+      fields.emplace_back(TypeId::kTypeFloat, value);
+      break;
+    }
+    case TypeId::kTypeChar: {
+      if (len > column->GetLength()) {
+        throw ErrorAt("value too long for column " + column->GetName() + ".");
+      }
+      fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(text), len, true);
+      break;
+    }
+    default:
+      throw ErrorAt("column " + column->GetName() + " has an invalid type.");
+  }
+}
+
+void BulkLoader::Flush() {
+  if (batch_.empty()) {
+    return;
+  }
+  // a failed batch leaves none of its rows in the table, Rollback() only has to delete those of the batches before it
+  dberr_t result = table_info_->GetTableHeap()->InsertTuples(batch_, exec_ctx_->GetTransaction());
+  if (result != DB_SUCCESS) {
+    batch_.clear();
+    throw std::string(result == DB_BUFFER_POOL_FULL ? "Buffer pool is full, rows not inserted!"
+                                                    : "Row too large to insert!");
+  }
+  for (auto &row : batch_) {
+    inserted_.push_back(row.GetRowId());
+    for (size_t i = 0; i < indexes_.size(); i++) {
+      keys_[i].emplace_back(MakeIndexKey(indexes_[i], row), row.GetRowId());
+    }
+  }
+  batch_.clear();
+}
+
+void BulkLoader::BuildIndexes() {
+  Transaction *txn = exec_ctx_->GetTransaction();
+  // every constraint is checked before the first entry goes in, so that a failed load leaves the indexes as they were
+  for (size_t i = 0; i < indexes_.size(); i++) {
+    std::sort(keys_[i].begin(), keys_[i].end(),
+              [](const auto &a, const auto &b) { return IndexKeyLess(a.first, b.first); });
+    if (!IsUniqueIndex(indexes_[i])) {
+      continue;
+    }
+    for (size_t k = 0; k < keys_[i].size(); k++) {
+      // a duplicate within the file, or of a row already in the table
+      bool duplicate = k > 0 && IndexKeyEquals(keys_[i][k - 1].first, keys_[i][k].first);
+      std::vector<RowId> res;
+      if (!duplicate) {
+        indexes_[i]->GetIndex()->ScanKey(keys_[i][k].first, res, txn, "=");
+      }
+      if (duplicate || !res.empty()) {
+        bool primary_key = indexes_[i]->GetIndexName() == "PRIMARY_KEY_";
+        throw std::string(primary_key ? "PK corruption!" : "Uniqueness constraint corruption!");
+      }
+    }
+  }
+  for (size_t i = 0; i < indexes_.size(); i++) {
+    for (auto &key : keys_[i]) {
+      indexes_[i]->GetIndex()->InsertEntry(key.first, key.second, txn);
+    }
+    keys_[i].clear();
+  }
+}
+
+void BulkLoader::Rollback() {
+  batch_.clear();
+  for (auto &rid : inserted_) {
+    table_info_->GetTableHeap()->ApplyDelete(rid, exec_ctx_->GetTransaction());
+  }
+  inserted_.clear();
+  for (auto &keys : keys_) {
+    keys.clear();
+  }
+}
+
+std::string BulkLoader::ErrorAt(const std::string &message) const {
+  return "Line " + std::to_string(line_no_) + ": " + message;
+}
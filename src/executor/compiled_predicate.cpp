@@ -0,0 +1,258 @@
+#include "executor/compiled_predicate.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "planner/expressions/logic_expression.h"
+
+namespace {
+
+/**
+ * The value of a non NULL field as the kernels of its type compare it. CHAR values compare as CompareStrings does,
+ * bytewise and a prefix first.
+ */
+template <TypeId type>
+struct FieldValue;
+
+template <>
+struct FieldValue<kTypeInt> {
+  using Raw = int32_t;  // the type of the values in a column vector
+  static int32_t Get(const Field &field) { return field.GetInt(); }
+  static int32_t Get(const Raw &value) { return value; }
+};
+
+template <>
+struct FieldValue<kTypeFloat> {
+  using Raw = float;
+  static float Get(const Field &field) { return field.GetFloat(); }
+  static float Get(const Raw &value) { return value; }
+};
+
+template <>
+struct FieldValue<kTypeChar> {
+  using Raw = CharValue;
+  static std::string_view Get(const Field &field) { return {field.GetChars(), field.GetCharLength()}; }
+  static std::string_view Get(const Raw &value) { return {value.data_, value.len_}; }
+};
+
+template <ComparisonType op, typename T>
+inline bool Compare(const T &lhs, const T &rhs) {
+  if constexpr (op == ComparisonType::Equal) {
+    return lhs == rhs;
+  } else if constexpr (op == ComparisonType::NotEqual) {
+    return lhs != rhs;
+  } else if constexpr (op == ComparisonType::LessThan) {
+    return lhs < rhs;
+  } else if constexpr (op == ComparisonType::LessThanOrEqual) {
+    return lhs <= rhs;
+  } else if constexpr (op == ComparisonType::GreaterThan) {
+    return lhs > rhs;
+  } else {
+    return lhs >= rhs;
+  }
+}
+
+template <TypeId type, ComparisonType op>
+bool CompareColumn(const PredicateNode &node, const Row &row) {
+  const Field *field = row.GetField(node.column_);
+  return !field->IsNull() && Compare<op>(FieldValue<type>::Get(*field), FieldValue<type>::Get(node.constant_));
+}
+
+template <TypeId type, ComparisonType op>
+uint32_t SelectColumn(const PredicateNode &node, const DataChunk &chunk, const uint32_t *selection, uint32_t count,
+                      uint32_t *out) {
+  const ColumnVector &column = chunk.GetColumn(node.column_);
+  const auto *values = column.GetData<typename FieldValue<type>::Raw>();
+  const uint8_t *nulls = column.GetNulls();
+  auto constant = FieldValue<type>::Get(node.constant_);
+  uint32_t selected = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t index = selection[i];
+    out[selected] = index;
+    selected += !nulls[index] && Compare<op>(FieldValue<type>::Get(values[index]), constant);
+  }
+  return selected;
+}
+
+template <bool is_null>
+bool CheckNull(const PredicateNode &node, const Row &row) {
+  return row.GetField(node.column_)->IsNull() == is_null;
+}
+
+template <bool is_null>
+uint32_t SelectNull(const PredicateNode &node, const DataChunk &chunk, const uint32_t *selection, uint32_t count,
+                    uint32_t *out) {
+  const uint8_t *nulls = chunk.GetColumn(node.column_).GetNulls();
+  uint32_t selected = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t index = selection[i];
+    out[selected] = index;
+    selected += (nulls[index] != 0) == is_null;
+  }
+  return selected;
+}
+
+/** A comparison with a NULL constant */
+bool Never(const PredicateNode &, const Row &) { return false; }
+
+uint32_t SelectNone(const PredicateNode &, const DataChunk &, const uint32_t *, uint32_t, uint32_t *) { return 0; }
+
+template <LogicType type>
+bool Combine(const PredicateNode &node, const Row &row) {
+  if constexpr (type == LogicType::And) {
+    return node.left_->kernel_(*node.left_, row) && node.right_->kernel_(*node.right_, row);
+  } else {
+    return node.left_->kernel_(*node.left_, row) || node.right_->kernel_(*node.right_, row);
+  }
+}
+
+template <LogicType type>
+uint32_t SelectCombined(const PredicateNode &node, const DataChunk &chunk, const uint32_t *selection, uint32_t count,
+                        uint32_t *out) {
+  const PredicateNode &left = *node.left_;
+  const PredicateNode &right = *node.right_;
+  if constexpr (type == LogicType::And) {
+    // the right operand only tests the rows the left one selected
+    uint32_t selected = left.batch_kernel_(left, chunk, selection, count, out);
+    return right.batch_kernel_(right, chunk, out, selected, out);
+  } else {
+    if (node.left_selection_.size() < count) {
+      node.left_selection_.resize(count);
+      node.right_selection_.resize(count);
+    }
+    uint32_t *left_selection = node.left_selection_.data();
+    uint32_t *right_selection = node.right_selection_.data();
+    uint32_t left_count = left.batch_kernel_(left, chunk, selection, count, left_selection);
+    uint32_t right_count = right.batch_kernel_(right, chunk, selection, count, right_selection);
+    return std::set_union(left_selection, left_selection + left_count, right_selection,
+                          right_selection + right_count, out) - out;
+  }
+}
+
+bool EvaluateExpression(const PredicateNode &node, const Row &row) {
+  Field value = node.expression_->Evaluate(&row);
+  return !value.IsNull() && value.GetTypeId() == kTypeInt && value.GetInt() == 1;
+}
+
+/** The expression is evaluated on each row, taken out of the chunk */
+uint32_t SelectByExpression(const PredicateNode &node, const DataChunk &chunk, const uint32_t *selection,
+                            uint32_t count, uint32_t *out) {
+  uint32_t selected = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t index = selection[i];
+    chunk.GetRow(index, &node.row_);
+    out[selected] = index;
+    selected += EvaluateExpression(node, node.row_);
+  }
+  return selected;
+}
+
+template <TypeId type, ComparisonType op>
+void SetKernels(PredicateNode *node) {
+  node->kernel_ = &CompareColumn<type, op>;
+  node->batch_kernel_ = &SelectColumn<type, op>;
+}
+
+template <TypeId type>
+void SelectComparison(ComparisonType op, PredicateNode *node) {
+  switch (op) {
+    case ComparisonType::Equal:
+      return SetKernels<type, ComparisonType::Equal>(node);
+    case ComparisonType::NotEqual:
+      return SetKernels<type, ComparisonType::NotEqual>(node);
+    case ComparisonType::LessThan:
+      return SetKernels<type, ComparisonType::LessThan>(node);
+    case ComparisonType::LessThanOrEqual:
+      return SetKernels<type, ComparisonType::LessThanOrEqual>(node);
+    case ComparisonType::GreaterThan:
+      return SetKernels<type, ComparisonType::GreaterThan>(node);
+    case ComparisonType::GreaterThanOrEqual:
+      return SetKernels<type, ComparisonType::GreaterThanOrEqual>(node);
+    default:
+      break;
+  }
+}
+
+}  // namespace
+
+CompiledPredicate::CompiledPredicate(const AbstractExpressionRef &expression) {
+  if (expression != nullptr) {
+    root_ = Compile(expression);
+  }
+}
+
+void CompiledPredicate::Select(DataChunk &chunk) const {
+  if (root_ != nullptr) {
+    uint32_t *selection = chunk.GetSelectionVector();
+    chunk.SetCount(root_->batch_kernel_(*root_, chunk, selection, chunk.GetCount(), selection));
+  }
+}
+
+const PredicateNode *CompiledPredicate::Compile(const AbstractExpressionRef &expression) {
+  auto node = std::make_unique<PredicateNode>();
+  node->kernel_ = &EvaluateExpression;
+  node->batch_kernel_ = &SelectByExpression;
+  node->expression_ = expression.get();
+  switch (expression->GetType()) {
+    case ExpressionType::LogicExpression: {
+      auto logic_type = std::dynamic_pointer_cast<LogicExpression>(expression)->logic_type_;
+      node->left_ = Compile(expression->GetChildAt(0));
+      node->right_ = Compile(expression->GetChildAt(1));
+      node->kernel_ = logic_type == LogicType::And ? &Combine<LogicType::And> : &Combine<LogicType::Or>;
+      node->batch_kernel_ =
+          logic_type == LogicType::And ? &SelectCombined<LogicType::And> : &SelectCombined<LogicType::Or>;
+      break;
+    }
+    case ExpressionType::ComparisonExpression:
+      CompileComparison(*std::dynamic_pointer_cast<ComparisonExpression>(expression), node.get());
+      break;
+    default:
+      break;
+  }
+  nodes_.push_back(std::move(node));
+  return nodes_.back().get();
+}
+
+void CompiledPredicate::CompileComparison(const ComparisonExpression &comparison, PredicateNode *node) {
+  auto &left = comparison.GetChildAt(0);
+  auto &right = comparison.GetChildAt(1);
+  if (left->GetType() != ExpressionType::ColumnExpression) {
+    return;
+  }
+  node->column_ = std::dynamic_pointer_cast<ColumnValueExpression>(left)->GetColIdx();
+  ComparisonType op = comparison.GetComparisonOp();
+  if (op == ComparisonType::IsNull || op == ComparisonType::IsNotNull) {
+    node->kernel_ = op == ComparisonType::IsNull ? &CheckNull<true> : &CheckNull<false>;
+    node->batch_kernel_ = op == ComparisonType::IsNull ? &SelectNull<true> : &SelectNull<false>;
+    return;
+  }
+  if (right->GetType() != ExpressionType::ConstantExpression) {
+    return;
+  }
+  const Field &constant = std::dynamic_pointer_cast<ConstantValueExpression>(right)->val_;
+  TypeId type = left->GetReturnType();
+  if (constant.GetTypeId() != type) {
+    return;
+  }
+  if (constant.IsNull()) {
+    node->kernel_ = &Never;
+    node->batch_kernel_ = &SelectNone;
+    return;
+  }
+  node->constant_ = constant;
+  switch (type) {
+    case kTypeInt:
+      SelectComparison<kTypeInt>(op, node);
+      break;
+    case kTypeFloat:
+      SelectComparison<kTypeFloat>(op, node);
+      break;
+    case kTypeChar:
+      SelectComparison<kTypeChar>(op, node);
+      break;
+    default:
+      break;
+  }
+}
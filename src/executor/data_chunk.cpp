@@ -0,0 +1,136 @@
+#include "executor/data_chunk.h"
+
+#include <algorithm>
+#include <cstring>
+
+uint32_t ColumnVector::GetValueWidth(TypeId type) {
+  switch (type) {
+    case kTypeInt:
+      return sizeof(int32_t);
+    case kTypeFloat:
+      return sizeof(float);
+    case kTypeChar:
+      return sizeof(CharValue);
+    default:
+      return 0;
+  }
+}
+
+void ColumnVector::Init(TypeId type, uint32_t capacity) {
+  type_ = type;
+  data_.resize(static_cast<size_t>(GetValueWidth(type)) * capacity);
+  nulls_.resize(capacity);
+}
+
+void DataChunk::Init(const std::vector<TypeId> &types, uint32_t capacity) {
+  capacity_ = capacity;
+  columns_.resize(types.size());
+  for (size_t i = 0; i < types.size(); i++) {
+    columns_[i].Init(types[i], capacity);
+  }
+  rids_.resize(capacity);
+  selection_.resize(capacity);
+  Reset();
+}
+
+void DataChunk::Reset() {
+  size_ = 0;
+  count_ = 0;
+  arena_.Reset();
+}
+
+void DataChunk::AppendRow(const Row &row, RowId rid) {
+  if (size_ == 0) {
+    bool same_layout = columns_.size() == row.GetFieldCount();
+    for (uint32_t i = 0; same_layout && i < columns_.size(); i++) {
+      same_layout = columns_[i].GetType() == row.GetField(i)->GetTypeId();
+    }
+    if (!same_layout) {
+      std::vector<TypeId> types;
+      for (uint32_t i = 0; i < row.GetFieldCount(); i++) {
+        types.push_back(row.GetField(i)->GetTypeId());
+      }
+      Init(types);
+    }
+  }
+  ASSERT(size_ < capacity_, "The chunk is full.");
+  ASSERT(row.GetFieldCount() == columns_.size(), "Fields size do not match the columns of the chunk.");
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    ColumnVector &column = columns_[i];
+    const Field *field = row.GetField(i);
+    column.GetNulls()[size_] = field->IsNull();
+    if (field->IsNull()) {
+      continue;
+    }
+    switch (column.GetType()) {
+      case kTypeInt:
+        column.GetData<int32_t>()[size_] = field->GetInt();
+        break;
+      case kTypeFloat:
+        column.GetData<float>()[size_] = field->GetFloat();
+        break;
+      case kTypeChar:
+        ASSERT(!field->IsOverflow(), "The value in overflow pages is not loaded.");
+        column.GetData<CharValue>()[size_] = {arena_.CopyChars(field->GetChars(), field->GetCharLength()),
+                                              field->GetCharLength()};
+        break;
+      default:
+        ASSERT(false, "Unsupported column type.");
+    }
+  }
+  rids_[size_] = rid;
+  selection_[count_++] = size_++;
+}
+
+void DataChunk::GetRow(uint32_t index, Row *row) const {
+  row->ResizeFields(columns_.size());
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    const ColumnVector &column = columns_[i];
+    if (column.IsNull(index)) {
+      row->SetField(i, Field(column.GetType()));
+      continue;
+    }
+    switch (column.GetType()) {
+      case kTypeInt:
+        row->SetField(i, Field(kTypeInt, column.GetData<int32_t>()[index]));
+        break;
+      case kTypeFloat:
+        row->SetField(i, Field(kTypeFloat, column.GetData<float>()[index]));
+        break;
+      case kTypeChar: {
+        const CharValue &value = column.GetData<CharValue>()[index];
+        row->SetField(i, Field(kTypeChar, const_cast<char *>(value.data_), value.len_, false));
+        break;
+      }
+      default:
+        ASSERT(false, "Unsupported column type.");
+    }
+  }
+  row->SetRowId(rids_[index]);
+}
+
+void DataChunk::Project(const DataChunk &source, const std::vector<uint32_t> &columns) {
+  bool same_layout = columns_.size() == columns.size() && capacity_ == source.capacity_;
+  for (uint32_t i = 0; same_layout && i < columns.size(); i++) {
+    same_layout = columns_[i].GetType() == source.columns_[columns[i]].GetType();
+  }
+  if (!same_layout) {
+    std::vector<TypeId> types;
+    for (auto column : columns) {
+      types.push_back(source.columns_[column].GetType());
+    }
+    Init(types, source.capacity_);
+  }
+  Reset();
+  size_ = source.size_;
+  count_ = source.count_;
+  for (uint32_t i = 0; i < columns.size(); i++) {
+    const ColumnVector &from = source.columns_[columns[i]];
+    ColumnVector &to = columns_[i];
+    size_t width = ColumnVector::GetValueWidth(from.GetType());
+    memcpy(to.GetData<char>(), from.GetData<char>(), width * size_);
+    memcpy(to.GetNulls(), from.GetNulls(), size_);
+  }
+  std::copy(source.rids_.begin(), source.rids_.begin() + size_, rids_.begin());
+  std::copy(source.selection_.begin(), source.selection_.begin() + count_, selection_.begin());
+}
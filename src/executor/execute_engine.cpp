@@ -5,8 +5,11 @@
 #include <sys/types.h>
 
 #include <chrono>
+#include <fstream>
 
+#include "buffer/background_writer.h"
 #include "common/result_writer.h"
+#include "executor/bulk_loader.h"
 #include "executor/executors/delete_executor.h"
 #include "executor/executors/index_scan_executor.h"
 #include "executor/executors/insert_executor.h"
@@ -32,7 +35,11 @@ ExecuteEngine::ExecuteEngine() {
         strcmp( stdir->d_name , "..") == 0 ||
         stdir->d_name[0] == '.')
       continue;
-    dbs_[stdir->d_name] = new DBStorageEngine(stdir->d_name, false);
+    try {
+      dbs_[stdir->d_name] = new DBStorageEngine(stdir->d_name, false);
+    } catch (const std::runtime_error &e) {
+      LOG(ERROR) << "Skipping database " << stdir->d_name << ": " << e.what();
+    }
   }
 
   closedir(dir);
@@ -81,11 +88,21 @@ dberr_t ExecuteEngine::ExecutePlan(const AbstractPlanNodeRef &plan, std::vector<
 
   try {
     executor->Init();
-    RowId rid{};
-    Row row{};
-    while (executor->Next(&row, &rid)) {
-      if (result_set != nullptr) {
-        result_set->push_back(row);
+    if (result_set != nullptr) {
+      // the result is pulled a batch at a time, its rows live in the arena of the query until its context goes
+      DataChunk chunk;
+      while (executor->NextBatch(chunk)) {
+        for (uint32_t i = 0; i < chunk.GetCount(); i++) {
+          result_set->emplace_back(exec_ctx->GetArena());
+          chunk.GetRow(chunk.GetSelection(i), &result_set->back());
+        }
+      }
+    } else {
+      // without a result set the executors keep filling the same row in place. It is kept on the heap: the fields an
+      // executor assigns to it would pile up in the arena of the query, which only holds the rows that are kept
+      RowId rid{};
+      Row row;
+      while (executor->Next(&row, &rid)) {
       }
     }
   } catch (const string &ex) {
@@ -93,8 +110,10 @@ dberr_t ExecuteEngine::ExecutePlan(const AbstractPlanNodeRef &plan, std::vector<
     if (result_set != nullptr) {
       result_set->clear();
     }
+    last_query_arena_ = exec_ctx->GetArena()->GetStats();
     return DB_FAILED;
   }
+  last_query_arena_ = exec_ctx->GetArena()->GetStats();
   return DB_SUCCESS;
 }
 
@@ -127,6 +146,8 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
       return ExecuteCreateIndex(ast, context.get());
     case kNodeDropIndex:
       return ExecuteDropIndex(ast, context.get());
+    case kNodeShowStatus:
+      return ExecuteShowStatus(ast, context.get());
     case kNodeTrxBegin:
       return ExecuteTrxBegin(ast, context.get());
     case kNodeTrxCommit:
@@ -135,6 +156,8 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
       return ExecuteTrxRollback(ast, context.get());
     case kNodeExecFile:
       return ExecuteExecfile(ast, context.get());
+    case kNodeCopy:
+      return ExecuteCopy(ast, context.get());
     case kNodeQuit:
       return ExecuteQuit(ast, context.get());
     default:
@@ -228,6 +251,9 @@ void ExecuteEngine::ExecuteInformation(dberr_t result) {
     case DB_KEY_NOT_FOUND:
       cout << "Key not exists." << endl;
       break;
+    case DB_BUFFER_POOL_FULL:
+      cout << "Buffer pool is full." << endl;
+      break;
     case DB_QUIT:
       cout << "Bye." << endl;
       break;
@@ -350,6 +376,17 @@ dberr_t ExecuteEngine::ExecuteCreateTable(pSyntaxNode ast, ExecuteContext *conte
   }
   string table_name = ast->child_->val_;
   pSyntaxNode columnDefinitions = ast->child_->next_;
+  // WITH (layout = row | pax)
+  TableLayout layout = TableLayout::kRow;
+  if (pSyntaxNode option = columnDefinitions->next_; option != nullptr) {
+    string option_name = option->child_->val_;
+    string option_value = option->child_->next_->val_;
+    if (option_name != "layout" || (option_value != "row" && option_value != "pax")) {
+      std::cout << "Unknown table option " << option_name << " = " << option_value << "." << std::endl;
+      return DB_FAILED;
+    }
+    layout = option_value == "pax" ? TableLayout::kPax : TableLayout::kRow;
+  }
   vector <Column*> columns;
   int index = 0;
   vector<string> pk_col_names;
@@ -418,8 +455,11 @@ dberr_t ExecuteEngine::ExecuteCreateTable(pSyntaxNode ast, ExecuteContext *conte
   }
   auto *schema = new Schema(columns);
   auto *table = TableInfo::Create();
-  auto err = context->GetCatalog()->CreateTable(table_name, schema, nullptr, table);
+  auto err = context->GetCatalog()->CreateTable(table_name, schema, nullptr, table, layout);
   if (err != DB_SUCCESS) {
+    if (layout == TableLayout::kPax && err == DB_FAILED) {
+      std::cout << "A row of table " << table_name << " does not fit a pax page." << std::endl;
+    }
     return err;
   }
   int unique_index = 0;
@@ -530,6 +570,88 @@ dberr_t ExecuteEngine::ExecuteDropIndex(pSyntaxNode ast, ExecuteContext *context
   return DB_INDEX_NOT_FOUND;
 }
 
+dberr_t ExecuteEngine::ExecuteShowStatus(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteShowStatus" << std::endl;
+#endif
+  if (current_db_.empty()) {
+    std::cout << "Please use a database." << std::endl;
+    return DB_FAILED;
+  }
+  DBStorageEngine *engine = dbs_[current_db_];
+  vector<pair<string, uint64_t>> status;
+  BufferPoolStats pool = engine->bpm_->GetStats();
+  status.emplace_back("buffer_pool_fetch_hits", pool.fetch_hits_);
+  status.emplace_back("buffer_pool_fetch_misses", pool.fetch_misses_);
+  status.emplace_back("buffer_pool_new_pages", pool.new_pages_);
+  status.emplace_back("buffer_pool_evictions", pool.evictions_);
+  status.emplace_back("buffer_pool_dirty_write_backs", pool.dirty_write_backs_);
+  status.emplace_back("buffer_pool_pages_flushed", pool.pages_flushed_);
+  status.emplace_back("buffer_pool_prefetches", pool.prefetches_);
+  DiskStats disk = engine->disk_mgr_->GetStats();
+  status.emplace_back("disk_reads", disk.reads_);
+  status.emplace_back("disk_writes", disk.writes_);
+  status.emplace_back("disk_bytes_read", disk.bytes_read_);
+  status.emplace_back("disk_bytes_written", disk.bytes_written_);
+  status.emplace_back("disk_flushes", disk.flushes_);
+  status.emplace_back("disk_allocations", disk.allocations_);
+  status.emplace_back("disk_deallocations", disk.deallocations_);
+  status.emplace_back("disk_checksum_failures", disk.checksum_failures_);
+  BackgroundWriter *bg_writer = engine->bpm_->GetBackgroundWriter();
+  if (bg_writer != nullptr) {
+    BackgroundWriterStats bg_stats = bg_writer->GetStats();
+    status.emplace_back("bgwriter_rounds", bg_stats.rounds_);
+    status.emplace_back("bgwriter_pages_written", bg_stats.pages_written_);
+    status.emplace_back("checkpoints", bg_stats.checkpoints_);
+    status.emplace_back("checkpoint_pages_written", bg_stats.checkpoint_pages_written_);
+  }
+  status.emplace_back("last_query_arena_allocations", last_query_arena_.allocations_);
+  status.emplace_back("last_query_arena_bytes", last_query_arena_.bytes_allocated_);
+  status.emplace_back("last_query_arena_blocks", last_query_arena_.blocks_);
+  status.emplace_back("last_query_arena_peak_bytes", last_query_arena_.peak_bytes_);
+  // fetches charged to each table and index
+  vector<TableInfo *> tables;
+  context->GetCatalog()->GetTables(tables);
+  for (auto table : tables) {
+    string table_name = table->GetTableName();
+    AccessStats *table_stats = table->GetTableHeap()->GetAccessStats();
+    status.emplace_back("table." + table_name + ".fetch_hits", table_stats->GetFetchHits());
+    status.emplace_back("table." + table_name + ".fetch_misses", table_stats->GetFetchMisses());
+    vector<IndexInfo *> indexes;
+    context->GetCatalog()->GetTableIndexes(table_name, indexes);
+    for (auto index : indexes) {
+      AccessStats *index_stats = index->GetIndex()->GetAccessStats();
+      if (index_stats == nullptr) {
+        continue;
+      }
+      string index_name = index->GetIndexName();
+      status.emplace_back("index." + index_name + ".fetch_hits", index_stats->GetFetchHits());
+      status.emplace_back("index." + index_name + ".fetch_misses", index_stats->GetFetchMisses());
+    }
+  }
+  vector<int> data_width{int(strlen("Variable_name")), int(strlen("Value"))};
+  for (const auto &item : status) {
+    data_width[0] = max(data_width[0], int(item.first.length()));
+    data_width[1] = max(data_width[1], int(to_string(item.second).length()));
+  }
+  ResultWriter writer(cout);
+  writer.Divider(data_width);
+  writer.BeginRow();
+  writer.WriteHeaderCell("Variable_name", data_width[0]);
+  writer.WriteHeaderCell("Value", data_width[1]);
+  writer.EndRow();
+  writer.Divider(data_width);
+  for (const auto &item : status) {
+    writer.BeginRow();
+    writer.WriteCell(item.first, data_width[0]);
+    writer.WriteCell(to_string(item.second), data_width[1]);
+    writer.EndRow();
+  }
+  writer.Divider(data_width);
+  cout << status.size() << " row in set." << endl;
+  return DB_SUCCESS;
+}
+
 
 dberr_t ExecuteEngine::ExecuteTrxBegin(pSyntaxNode ast, ExecuteContext *context) {
 #ifdef ENABLE_EXECUTE_DEBUG
@@ -572,17 +694,17 @@ dberr_t ExecuteEngine::ExecuteExecfile(pSyntaxNode ast, ExecuteContext *context)
     cout << "File " << file_name << " not found!" << endl;
     return DB_FAILED;
   }
-  char input[1024];
+  // a statement may be of any length, e.g. an insert of many tuples
+  std::string input;
   while(!feof(file)) {
-    memset(input, 0, 1024);
-    int i = 0;
-    char ch;
-    while (!feof(file) && (ch = getc(file)) != ';') {
-      input[i++] = ch;
+    input.clear();
+    int ch;
+    while ((ch = getc(file)) != EOF && ch != ';') {
+      input.push_back(static_cast<char>(ch));
     }
-    if (feof(file)) continue;
-    input[i] = ch;
-    YY_BUFFER_STATE bp = yy_scan_string(input);
+    if (ch == EOF) continue;
+    input.push_back(';');
+    YY_BUFFER_STATE bp = yy_scan_string(input.c_str());
     if (bp == nullptr) {
       LOG(ERROR) << "Failed to create yy buffer state." << std::endl;
       exit(1);
@@ -610,6 +732,40 @@ dberr_t ExecuteEngine::ExecuteExecfile(pSyntaxNode ast, ExecuteContext *context)
 
     ExecuteInformation(result);
   }
+  fclose(file);
+  return DB_SUCCESS;
+}
+
+dberr_t ExecuteEngine::ExecuteCopy(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteCopy" << std::endl;
+#endif
+  if (current_db_.empty()) {
+    std::cout << "Please use a database." << std::endl;
+    return DB_FAILED;
+  }
+  auto start_time = std::chrono::system_clock::now();
+  string table_name = ast->child_->val_;
+  string file_name = ast->child_->next_->val_;
+  TableInfo *table_info = nullptr;
+  dberr_t res = context->GetCatalog()->GetTable(table_name, table_info);
+  if (res != DB_SUCCESS) {
+    return res;
+  }
+  size_t row_count;
+  try {
+    row_count = BulkLoader(context, table_info).Load(file_name);
+  } catch (const string &ex) {
+    std::cout << "Error Encountered in Copy: " << ex << std::endl;
+    return DB_FAILED;
+  }
+  auto stop_time = std::chrono::system_clock::now();
+  double duration_time =
+      double((std::chrono::duration_cast<std::chrono::milliseconds>(stop_time - start_time)).count());
+  std::stringstream ss;
+  ResultWriter writer(ss);
+  writer.EndInformation(row_count, duration_time, false);
+  std::cout << writer.stream_.rdbuf();
   return DB_SUCCESS;
 }
 
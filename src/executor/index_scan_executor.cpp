@@ -75,31 +75,45 @@ void IndexScanExecutor::Init() {
     }
   }
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_);
+  output_columns_.clear();
+  for (auto column : original_schema_->GetColumns()) {
+    for (auto target : plan_->OutputSchema()->GetColumns()) {
+      if (!target->GetName().compare(column->GetName())) {
+        output_columns_.push_back(column->GetTableInd());
+      }
+    }
+  }
+  predicate_ = CompiledPredicate(plan_->GetPredicate());
+  std::vector<TypeId> types;
+  for (auto column : original_schema_->GetColumns()) {
+    types.push_back(column->GetType());
+  }
+  scan_chunk_.Init(types);
+  ResetBatch();
   it_ = index_results_.begin();
 }
 
-bool IndexScanExecutor::Next(Row *row, RowId *rid) {
-  while(it_ != index_results_.end()) {
-    Row* tuple = new Row(*it_);
-    table_->GetTableHeap()->GetTuple(tuple, nullptr);
-    if (plan_->GetPredicate()->Evaluate(tuple).CompareEquals(Field(kTypeInt, 1))) {
-      vector <Field> fields;
-      for (auto column: original_schema_->GetColumns()) {
-        for (auto target: plan_->OutputSchema()->GetColumns()) {
-          if (!target->GetName().compare(column->GetName())) {
-            fields.push_back(*tuple->GetField(column->GetTableInd()));
-          }
-        }
+bool IndexScanExecutor::Next(Row *row, RowId *rid) { return NextFromBatch(row, rid); }
+
+bool IndexScanExecutor::NextBatch(DataChunk &chunk) {
+  while (it_ != index_results_.end()) {
+    // the tuples of a batch of rids, then the predicate and the projection over the whole batch
+    scan_chunk_.Reset();
+    while (!scan_chunk_.IsFull() && it_ != index_results_.end()) {
+      tuple_.destroy();
+      row_arena_.Reset();
+      tuple_.SetRowId(*it_);
+      if (table_->GetTableHeap()->GetTuple(&tuple_, nullptr)) {
+        scan_chunk_.AppendRow(tuple_, *it_);
       }
-      *row = Row(fields);
-      row->SetRowId(*it_);
-      delete tuple;
-      *rid = *it_;
       ++it_;
+    }
+    predicate_.Select(scan_chunk_);
+    chunk.Project(scan_chunk_, output_columns_);
+    if (chunk.GetCount() > 0) {
       return true;
     }
-    delete tuple;
-    it_++;
   }
+  chunk.Reset();
   return false;
 }
@@ -4,54 +4,80 @@
 
 #include "executor/executors/insert_executor.h"
 
+#include <algorithm>
+
+#include "executor/index_key.h"
+
 InsertExecutor::InsertExecutor(ExecuteContext *exec_ctx, const InsertPlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
     : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
 
 void InsertExecutor::Init() {
   child_executor_->Init();
+  exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
+  indexes_.clear();
+  exec_ctx_->GetCatalog()->GetTableIndexes(plan_->GetTableName(), indexes_);
+  batch_.clear();
+  cursor_ = 0;
 }
 
 bool InsertExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
-  TableInfo* table;
-  exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table);
-  vector<IndexInfo*> indexes;
-  exec_ctx_->GetCatalog()->GetTableIndexes(plan_->GetTableName(), indexes);
-  if (child_executor_->Next(row, rid)) {
-    for (auto index: indexes) {
-      if (!index->GetIndexName().compare("PRIMARY_KEY_") && index->GetIndexKeySchema()->GetColumnCount() == 1) {
-        uint32_t col_idx = index->GetIndexKeySchema()->GetColumn(0)->GetTableInd();
-        Field *keyVal = row->GetField(col_idx);
-        std::vector<Field> keyData {Field(*keyVal)};
-        Row key = Row(keyData);
-        vector <RowId> res;
-        index->GetIndex()->ScanKey(key, res, nullptr, "=");
-        if (!res.empty()) {
-          throw string("PK corruption!");
-        }
+  if (cursor_ == batch_.size() && !InsertBatch()) {
+    return false;
+  }
+  *row = batch_[cursor_++];
+  *rid = row->GetRowId();
+  return true;
+}
+
+bool InsertExecutor::InsertBatch() {
+  batch_.clear();
+  cursor_ = 0;
+  Row row;
+  RowId rid;
+  while (batch_.size() < DEFAULT_INSERT_BATCH_SIZE && child_executor_->Next(&row, &rid)) {
+    batch_.push_back(row);
+  }
+  if (batch_.empty()) {
+    return false;
+  }
+  Transaction *txn = exec_ctx_->GetTransaction();
+  // the keys of each index sorted, so that the checks and the inserts walk the tree in key order
+  std::vector<std::vector<std::pair<Row, size_t>>> keys(indexes_.size());
+  for (size_t i = 0; i < indexes_.size(); i++) {
+    auto index = indexes_[i];
+    for (size_t j = 0; j < batch_.size(); j++) {
+      keys[i].emplace_back(MakeIndexKey(index, batch_[j]), j);
+    }
+    std::stable_sort(keys[i].begin(), keys[i].end(),
+                     [](const auto &a, const auto &b) { return IndexKeyLess(a.first, b.first); });
+    if (!IsUniqueIndex(index)) {
+      continue;
+    }
+    for (size_t k = 0; k < keys[i].size(); k++) {
+      // a duplicate within the batch, or of a row already in the table
+      bool duplicate = k > 0 && IndexKeyEquals(keys[i][k - 1].first, keys[i][k].first);
+      std::vector<RowId> res;
+      if (!duplicate) {
+        index->GetIndex()->ScanKey(keys[i][k].first, res, txn, "=");
       }
-      if (index->GetIndexName().find("__Unique") == 0 && index->GetIndexKeySchema()->GetColumnCount() == 1) {
-        uint32_t col_idx = index->GetIndexKeySchema()->GetColumn(0)->GetTableInd();
-        Field* fieldVal = row->GetField(col_idx);
-        std::vector<Field> uniqueData {Field(*fieldVal)};
-        Row unique = Row(uniqueData);
-        vector <RowId> res;
-        index->GetIndex()->ScanKey(unique, res, nullptr, "=");
-        if (!res.empty()) {
-          throw string("Uniqueness constraint corruption!");
-        }
+      if (duplicate || !res.empty()) {
+        batch_.clear();
+        bool primary_key = index->GetIndexName() == "PRIMARY_KEY_";
+        throw string(primary_key ? "PK corruption!" : "Uniqueness constraint corruption!");
       }
     }
-    table->GetTableHeap()->InsertTuple(*row, nullptr);
-    for (auto index: indexes) {
-      uint32_t col_idx = index->GetIndexKeySchema()->GetColumn(0)->GetTableInd();
-      Field *keyVal = row->GetField(col_idx);
-      std::vector<Field> keyData {Field(*keyVal)};
-      Row key = Row(keyData);
-      index->GetIndex()->InsertEntry(key, row->GetRowId(), nullptr);
+  }
+  dberr_t result = table_info_->GetTableHeap()->InsertTuples(batch_, txn);
+  if (result != DB_SUCCESS) {
+    batch_.clear();
+    throw string(result == DB_BUFFER_POOL_FULL ? "Buffer pool is full, rows not inserted!"
+                                               : "Row too large to insert!");
+  }
+  for (size_t i = 0; i < indexes_.size(); i++) {
+    for (auto &key : keys[i]) {
+      indexes_[i]->GetIndex()->InsertEntry(key.first, batch_[key.second].GetRowId(), txn);
     }
-    *rid = row->GetRowId();
-    return true;
   }
-  return false;
-}
\ No newline at end of file
+  return true;
+}
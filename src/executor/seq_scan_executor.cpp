@@ -3,6 +3,24 @@
 //
 #include "executor/executors/seq_scan_executor.h"
 
+#include <algorithm>
+
+#include "planner/expressions/column_value_expression.h"
+
+namespace {
+
+/** Collect the columns an expression reads */
+void CollectColumns(const AbstractExpressionRef &expr, std::vector<uint32_t> &columns) {
+  if (expr->GetType() == ExpressionType::ColumnExpression) {
+    columns.push_back(std::dynamic_pointer_cast<ColumnValueExpression>(expr)->GetColIdx());
+  }
+  for (auto &child : expr->GetChildren()) {
+    CollectColumns(child, columns);
+  }
+}
+
+}  // namespace
+
 /**
 * TODO: Student Implement
 */
@@ -15,27 +33,49 @@ void SeqScanExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), targetTable);
   tableHeap_ = targetTable->GetTableHeap();
   original_schema_ = targetTable->GetSchema();
-  it_ = tableHeap_->Begin(nullptr);
+  output_columns_.clear();
+  for (auto column : original_schema_->GetColumns()) {
+    for (auto target : plan_->OutputSchema()->GetColumns()) {
+      if (!target->GetName().compare(column->GetName())) {
+        output_columns_.push_back(column->GetTableInd());
+      }
+    }
+  }
+  scan_columns_ = output_columns_;
+  if (plan_->GetPredicate() != nullptr) {
+    CollectColumns(plan_->GetPredicate(), scan_columns_);
+  }
+  std::sort(scan_columns_.begin(), scan_columns_.end());
+  scan_columns_.erase(std::unique(scan_columns_.begin(), scan_columns_.end()), scan_columns_.end());
+  predicate_ = CompiledPredicate(plan_->GetPredicate());
+  std::vector<TypeId> types;
+  for (auto column : original_schema_->GetColumns()) {
+    types.push_back(column->GetType());
+  }
+  scan_chunk_.Init(types);
+  ResetBatch();
+  it_ = tableHeap_->Begin(nullptr, &strategy_);
 }
 
-bool SeqScanExecutor::Next(Row *row, RowId *rid) {
+bool SeqScanExecutor::Next(Row *row, RowId *rid) { return NextFromBatch(row, rid); }
+
+bool SeqScanExecutor::NextBatch(DataChunk &chunk) {
   while (it_ != tableHeap_->End()) {
-    if (plan_->GetPredicate() == nullptr || Field(kTypeInt, 1).CompareEquals(plan_->GetPredicate()->Evaluate(&*it_))) {
-      vector<Field> fields;
-      for (auto column : original_schema_->GetColumns()) {
-        for (auto target : plan_->OutputSchema()->GetColumns()) {
-          if (!target->GetName().compare(column->GetName())) {
-            fields.push_back(*it_->GetField(column->GetTableInd()));
-          }
-        }
-      }
-      *rid = RowId(it_->GetRowId());
-      *row = Row(fields);
-      row->SetRowId(*rid);
+    // the columns read of a batch of tuples, then the predicate and the projection over the whole batch
+    scan_chunk_.Reset();
+    while (!scan_chunk_.IsFull() && it_ != tableHeap_->End()) {
+      scan_row_.destroy();
+      row_arena_.Reset();
+      it_.GetRowView().Materialize(&scan_row_, original_schema_, &scan_columns_);
+      scan_chunk_.AppendRow(scan_row_, it_.GetRowId());
       ++it_;
+    }
+    predicate_.Select(scan_chunk_);
+    chunk.Project(scan_chunk_, output_columns_);
+    if (chunk.GetCount() > 0) {
       return true;
     }
-    else ++it_;
   }
+  chunk.Reset();
   return false;
 }
@@ -22,16 +22,16 @@ void UpdateExecutor::Init() {
 bool UpdateExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
   if (child_executor_->Next(row, rid)) {
     auto upd_attr = plan_->GetUpdateAttr();
-    vector<Field> fields;
+    Row newRow;
+    newRow.ResizeFields(row->GetFieldCount());
     for (size_t i = 0; i < row->GetFieldCount(); ++i) {
       if (upd_attr.count(i)) {
-        fields.emplace_back(Field(upd_attr[i]->Evaluate(row)));
+        newRow.SetField(i, upd_attr[i]->Evaluate(row));
       }
       else {
-        fields.emplace_back(Field(*row->GetField(i)));
+        newRow.SetField(i, *row->GetField(i));
       }
     }
-    Row newRow(fields);
     if (tableHeap_->UpdateTuple(newRow, *rid, nullptr)) {
       vector<IndexInfo *> indexes;
       exec_ctx_->GetCatalog()->GetTableIndexes(plan_->GetTableName(), indexes);
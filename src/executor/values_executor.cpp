@@ -13,12 +13,12 @@ void ValuesExecutor::Init() {
 
 bool ValuesExecutor::Next(Row *row, RowId *rid) {
   if (cursor_ < value_size_) {
-    std::vector<Field> values;
-    auto exprs = plan_->GetValues().at(cursor_);
-    for (auto expr : exprs) {
-      values.emplace_back(expr->Evaluate(nullptr));
+    const auto &exprs = plan_->GetValues().at(cursor_);
+    row->ResizeFields(exprs.size());
+    for (uint32_t i = 0; i < exprs.size(); i++) {
+      row->SetField(i, exprs[i]->Evaluate(nullptr));
     }
-    *row = Row{values};
+    row->SetRowId(RowId());
     cursor_++;
     return true;
   }
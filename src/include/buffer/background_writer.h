@@ -0,0 +1,71 @@
+#ifndef MINISQL_BACKGROUND_WRITER_H
+#define MINISQL_BACKGROUND_WRITER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+class BufferPoolManager;
+
+/**
+ * Tuning knobs of the background writer.
+ */
+struct BackgroundWriterOptions {
+  uint32_t interval_ms_{DEFAULT_BGWRITER_INTERVAL_MS};                // sleep time between two rounds
+  double clean_target_{DEFAULT_BGWRITER_CLEAN_TARGET};                // fraction of frames kept free or clean
+  uint32_t max_pages_per_round_{DEFAULT_BGWRITER_MAX_PAGES};          // max pages one instance writes per round
+  uint32_t checkpoint_interval_ms_{DEFAULT_CHECKPOINT_INTERVAL_MS};  // time between checkpoints, 0 disables them
+};
+
+/**
+ * Counters of the background writer, a consistent snapshot is not guaranteed.
+ */
+struct BackgroundWriterStats {
+  uint64_t rounds_{0};                    // number of rounds run
+  uint64_t pages_written_{0};             // pages cleaned ahead of eviction
+  uint64_t checkpoints_{0};               // number of checkpoints taken
+  uint64_t checkpoint_pages_written_{0};  // pages written by checkpoints
+};
+
+/**
+ * BackgroundWriter runs a thread which wakes up every `interval_ms_` and writes back dirty, unpinned pages in page id
+ * order until every buffer pool instance has `clean_target_` of its frames free or clean, so that foreground fetches
+ * find clean victims and rarely wait for a write. Every `checkpoint_interval_ms_` it also takes a checkpoint, writing
+ * back all the dirty, unpinned pages and the disk file meta page.
+ */
+class BackgroundWriter {
+ public:
+  BackgroundWriter(BufferPoolManager *buffer_pool_manager, const BackgroundWriterOptions &options);
+
+  /**
+   * Stops the writer thread.
+   */
+  ~BackgroundWriter();
+
+  DISALLOW_COPY_AND_MOVE(BackgroundWriter);
+
+  const BackgroundWriterOptions &GetOptions() const { return options_; }
+
+  BackgroundWriterStats GetStats() const;
+
+ private:
+  void Run();
+
+  BufferPoolManager *buffer_pool_manager_;
+  BackgroundWriterOptions options_;
+  std::thread thread_;
+  std::mutex latch_;
+  std::condition_variable cv_;
+  bool stop_{false};
+  std::atomic<uint64_t> rounds_{0};
+  std::atomic<uint64_t> pages_written_{0};
+  std::atomic<uint64_t> checkpoints_{0};
+  std::atomic<uint64_t> checkpoint_pages_written_{0};
+};
+
+#endif  // MINISQL_BACKGROUND_WRITER_H
@@ -0,0 +1,49 @@
+#ifndef MINISQL_BUFFER_ACCESS_STRATEGY_H
+#define MINISQL_BUFFER_ACCESS_STRATEGY_H
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * The frames a bulk operation has used inside one buffer pool instance, oldest first.
+ */
+struct BufferRing {
+  size_t capacity_{0};
+  std::deque<std::pair<frame_id_t, page_id_t>> frames_;  // frame and the page the ring brought into it
+};
+
+/**
+ * BufferAccessStrategy is a small private ring of frames for bulk operations such as sequential scans. Once the ring
+ * is full, a page missed through the strategy replaces the oldest page the ring itself brought in (if nobody else
+ * uses it) instead of a victim chosen by the replacer, so a full scan recycles a few frames and leaves the working set
+ * of the buffer pool alone. A strategy belongs to one scan and must not be shared between threads.
+ */
+class BufferAccessStrategy {
+ public:
+  explicit BufferAccessStrategy(size_t ring_size = DEFAULT_SCAN_RING_SIZE) : ring_size_(ring_size) {}
+
+  size_t GetRingSize() const { return ring_size_; }
+
+  /**
+   * @return the ring of one buffer pool instance, the frames are split evenly between the instances
+   */
+  BufferRing *GetRing(size_t instance_index, size_t num_instances) {
+    if (rings_.size() != num_instances) {
+      rings_.assign(num_instances, BufferRing());
+      for (auto &ring : rings_) {
+        ring.capacity_ = std::max<size_t>(1, ring_size_ / num_instances);
+      }
+    }
+    return &rings_[instance_index];
+  }
+
+ private:
+  size_t ring_size_;
+  std::vector<BufferRing> rings_;
+};
+
+#endif  // MINISQL_BUFFER_ACCESS_STRATEGY_H
@@ -1,59 +1,141 @@
 #ifndef MINISQL_BUFFER_POOL_MANAGER_H
 #define MINISQL_BUFFER_POOL_MANAGER_H
 
-#include <list>
-#include <mutex>
-#include <thread>
-#include <unordered_map>
+#include <atomic>
+#include <vector>
 
-#include "buffer/lru_replacer.h"
+#include "buffer/background_writer.h"
+#include "buffer/buffer_pool_manager_instance.h"
 #include "page/disk_file_meta_page.h"
 #include "page/page.h"
 #include "storage/disk_manager.h"
+#include "storage/page_reservation.h"
 
 using namespace std;
 
+/**
+ * BufferPoolManager splits its frames into several independent BufferPoolManagerInstances and routes every page to
+ * the instance `page_id % num_instances`. Each instance has its own latch, page table, free list and replacer, so
+ * sessions touching different pages do not serialize on a single lock. The instances share one DiskScheduler whose
+ * worker threads perform the page reads and writes.
+ */
 class BufferPoolManager {
  public:
-  explicit BufferPoolManager(size_t pool_size, DiskManager *disk_manager);
+  explicit BufferPoolManager(size_t pool_size, DiskManager *disk_manager, size_t num_instances = 1,
+                             ReplacerType replacer_type = ReplacerType::kLRUReplacer);
 
   ~BufferPoolManager();
 
-  Page *FetchPage(page_id_t page_id);
+  /**
+   * Fetch a page. Pages missed through a strategy recycle the frames of its ring instead of evicting other pages.
+   */
+  Page *FetchPage(page_id_t page_id, BufferAccessStrategy *strategy = nullptr);
 
   bool UnpinPage(page_id_t page_id, bool is_dirty);
 
+  /**
+   * Start reading a page in the background, a later FetchPage of the page does not wait for the full read.
+   * @return false if the page is already resident, or no frame could be spared
+   */
+  bool Prefetch(page_id_t page_id, BufferAccessStrategy *strategy = nullptr);
+
+  /**
+   * Read-ahead hint of a chain scan (table heap pages, B+ tree leaves) which just reached `current_page_id`, whose
+   * successor is `next_page_id`. The successor is prefetched. If the chain is laid out sequentially on disk
+   * (`next_page_id == current_page_id + 1`), the pages following it are prefetched too, up to the read-ahead window.
+   */
+  void ReadAhead(page_id_t current_page_id, page_id_t next_page_id, BufferAccessStrategy *strategy = nullptr);
+
+  /**
+   * Set the number of pages ReadAhead() prefetches, 0 disables read-ahead.
+   */
+  void SetReadAheadWindow(size_t window) { read_ahead_window_ = window; }
+
+  size_t GetReadAheadWindow() const { return read_ahead_window_; }
+
   bool FlushPage(page_id_t page_id);
 
-  Page *NewPage(page_id_t &page_id);
+  /**
+   * Create a new page. With a reservation the page id is taken from its run of contiguous pages, a new run of
+   * `GetRunSize()` pages is reserved on disk when the run is used up.
+   */
+  Page *NewPage(page_id_t &page_id, PageReservation *reservation = nullptr);
+
+  /**
+   * Give the pages of a reservation which were not handed out yet back to the disk manager.
+   */
+  void ReleaseReservation(PageReservation *reservation);
 
   bool DeletePage(page_id_t page_id);
 
+  /**
+   * Delete a page from the pool and free it on disk, for a page no one refers to any more.
+   * @return false if the page is pinned, it is not freed then
+   */
+  bool FreePage(page_id_t page_id);
+
   bool IsPageFree(page_id_t page_id);
 
   bool CheckAllUnpinned();
 
+  /**
+   * Clean dirty, unpinned pages ahead of eviction in every instance, see BufferPoolManagerInstance::FlushDirtyPages.
+   * @return the number of pages written
+   */
+  size_t FlushDirtyPages(double clean_target, size_t max_pages_per_instance);
+
+  /**
+   * Write back every dirty, unpinned page and the disk file meta page, then sync the disk file. It runs on the
+   * background writer thread, so the pinned pages are left to a later checkpoint or to shutdown: their users modify
+   * them without a latch the copy could take.
+   * @return the number of pages written
+   */
+  size_t Checkpoint();
+
+  /**
+   * Start the background writer, a running writer is replaced.
+   */
+  void StartBackgroundWriter(const BackgroundWriterOptions &options = BackgroundWriterOptions());
+
+  void StopBackgroundWriter();
+
+  /** @return the running background writer, nullptr if there is none */
+  BackgroundWriter *GetBackgroundWriter() { return background_writer_; }
+
+  /** @return a snapshot of the counters summed over all the instances */
+  BufferPoolStats GetStats() const;
+
+  /** @return the total number of frames over all instances */
+  size_t GetPoolSize() const { return pool_size_; }
+
+  /** @return the number of buffer pool instances */
+  size_t GetNumInstances() const { return instances_.size(); }
+
  private:
   /**
    * Allocate new page (operations like create index/table) For now just keep an increasing counter
    */
-  page_id_t AllocatePage();
+  page_id_t AllocatePage(PageReservation *reservation = nullptr);
 
   /**
    * Deallocate page (operations like drop index/table) Need bitmap in header page for tracking pages
    */
   void DeallocatePage(page_id_t page_id);
 
-  frame_id_t TryToFindFreePage();
+  /**
+   * @return the instance responsible for the page
+   */
+  BufferPoolManagerInstance *GetInstance(page_id_t page_id) {
+    return instances_[static_cast<size_t>(page_id) % instances_.size()];
+  }
 
  private:
-  size_t pool_size_;                                 // number of pages in buffer pool
-  Page *pages_;                                      // array of pages
-  DiskManager *disk_manager_;                        // pointer to the disk manager.
-  unordered_map<page_id_t, frame_id_t> page_table_;  // to keep track of pages
-  Replacer *replacer_;                               // to find an unpinned page for replacement
-  list<frame_id_t> free_list_;                       // to find a free page for replacement
-  recursive_mutex latch_;                            // to protect shared data structure
+  size_t pool_size_;                                // number of pages in buffer pool
+  DiskManager *disk_manager_;                       // pointer to the disk manager.
+  DiskScheduler *disk_scheduler_;                   // I/O workers shared by all the instances
+  vector<BufferPoolManagerInstance *> instances_;  // partitions of the buffer pool
+  BackgroundWriter *background_writer_{nullptr};    // cleans dirty pages ahead of eviction
+  std::atomic<size_t> read_ahead_window_{DEFAULT_READ_AHEAD_PAGES};  // pages prefetched by ReadAhead()
 };
 
 #endif  // MINISQL_BUFFER_POOL_MANAGER_H
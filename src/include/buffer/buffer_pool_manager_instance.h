@@ -0,0 +1,158 @@
+#ifndef MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
+#define MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "buffer/buffer_access_strategy.h"
+#include "buffer/clock_replacer.h"
+#include "buffer/lru_k_replacer.h"
+#include "buffer/lru_replacer.h"
+#include "common/statistics.h"
+#include "page/page.h"
+#include "storage/disk_scheduler.h"
+
+using namespace std;
+
+/**
+ * BufferPoolManagerInstance is one partition of the buffer pool. It owns a slice of frames together with its own page
+ * table, free list, replacer and latch, so that instances never contend with each other. Page ids are handed out by
+ * the owning BufferPoolManager, which routes every request to the instance responsible for that page. All the disk I/O
+ * goes through the shared DiskScheduler.
+ *
+ * If the disk manager is memory mapped, the instance has no frame buffers of its own: a frame is pointed straight at
+ * its page inside the mapping, so a miss costs no read and no copy. Write-backs still go through the DiskScheduler,
+ * after which the private copy of a dirtied page is dropped once the page leaves the pool.
+ */
+class BufferPoolManagerInstance {
+ public:
+  explicit BufferPoolManagerInstance(size_t pool_size, DiskScheduler *disk_scheduler,
+                                     ReplacerType replacer_type = ReplacerType::kLRUReplacer);
+
+  ~BufferPoolManagerInstance();
+
+  /**
+   * Fetch a page, on a miss the frame is taken from `ring` first if one is given.
+   * @return nullptr if all the frames of this instance are pinned, or the page failed its checksum
+   */
+  Page *FetchPage(page_id_t page_id, BufferRing *ring = nullptr);
+
+  bool UnpinPage(page_id_t page_id, bool is_dirty);
+
+  bool FlushPage(page_id_t page_id);
+
+  /**
+   * Bring a freshly allocated page into the pool, the page id must already be allocated on disk.
+   * @return nullptr if all the frames of this instance are pinned
+   */
+  Page *NewPage(page_id_t page_id);
+
+  /**
+   * Start reading a page into a free or clean frame without pinning it, the read completes in the background. A later
+   * FetchPage of the page waits for the read instead of issuing its own.
+   * @return false if the page is already resident, or no frame could be spared. In memory mapped mode only the kernel
+   * read-ahead of the page is started and false is returned.
+   */
+  bool Prefetch(page_id_t page_id, BufferRing *ring = nullptr);
+
+  /**
+   * Drop a page from the pool, writing it back first if it is dirty.
+   * @return false if the page is still pinned
+   */
+  bool DeletePage(page_id_t page_id);
+
+  /**
+   * Write back dirty, unpinned pages in page id order until `clean_target` of the frames are free or clean and
+   * unpinned, writing at most `max_pages` pages. Used by the background writer.
+   * @return the number of pages written
+   */
+  size_t FlushDirtyPages(double clean_target, size_t max_pages);
+
+  /**
+   * Write back every dirty page in page id order. Pinned pages are written but stay dirty, since their users may still
+   * be modifying them.
+   * @param include_pinned false to skip the pinned pages, whose users may be modifying them while they are copied
+   * @return the number of pages written
+   */
+  size_t FlushAllPages(bool include_pinned = true);
+
+  bool CheckAllUnpinned();
+
+  size_t GetPoolSize() const { return pool_size_; }
+
+  /** @return a snapshot of the counters of this instance */
+  BufferPoolStats GetStats() const;
+
+ private:
+  frame_id_t TryToFindFreePage();
+
+  /**
+   * Take back the oldest frame of a full ring, provided it still holds the page the ring brought in and is unpinned.
+   * @return INVALID_FRAME_ID if the ring has no reusable frame
+   */
+  frame_id_t TryToReuseRingFrame(BufferRing *ring);
+
+  /**
+   * Count a fetch, also against the table or index of the current StatsScope.
+   */
+  void CountFetch(bool hit);
+
+  /**
+   * Wait until a prefetch of the page, if any, has completed. A page which failed its checksum is discarded.
+   * @return false if the page was discarded
+   */
+  bool WaitForPrefetch(page_id_t page_id);
+
+  /**
+   * Hand the frames of completed prefetches nobody has fetched yet over to the replacer.
+   */
+  void ReapPrefetches();
+
+  /**
+   * Drop the page held by an unpinned frame without writing it back and return the frame to the free list.
+   */
+  void DiscardFrame(frame_id_t frame_id);
+
+  /**
+   * Write back the given frames in page id order with all the writes in flight at once.
+   */
+  void FlushFrames(vector<frame_id_t> &frame_ids);
+
+  /**
+   * Start writing back the dirty page held by a victim frame. The data is copied aside first, so the frame can be
+   * refilled while the write is still in flight. In memory mapped mode the write completes before returning and the
+   * mapped page is released.
+   * @return a future of the write, or an invalid future if the frame was clean
+   */
+  std::future<bool> WriteBackVictim(frame_id_t frame_id);
+
+  /**
+   * Point a frame at the data of a page, only needed in memory mapped mode.
+   */
+  void MapFrame(frame_id_t frame_id, page_id_t page_id);
+
+ private:
+  size_t pool_size_;                                 // number of pages in this instance
+  Page *pages_;                                      // array of pages
+  char *frames_{nullptr};                            // data of the pages, nullptr in memory mapped mode
+  DiskScheduler *disk_scheduler_;                    // pointer to the shared disk scheduler.
+  DiskManager *mapped_disk_manager_{nullptr};        // the disk manager if it is memory mapped, nullptr otherwise
+  char write_back_buffer_[PAGE_SIZE];                // copy of the victim page being written back
+  std::atomic<uint64_t> fetch_hits_{0};              // counters, see BufferPoolStats
+  std::atomic<uint64_t> fetch_misses_{0};
+  std::atomic<uint64_t> new_pages_{0};
+  std::atomic<uint64_t> evictions_{0};
+  std::atomic<uint64_t> dirty_write_backs_{0};
+  std::atomic<uint64_t> pages_flushed_{0};
+  std::atomic<uint64_t> prefetches_{0};
+  unordered_map<page_id_t, std::future<bool>> prefetching_;  // prefetched pages not yet handed to the replacer
+  unordered_map<page_id_t, frame_id_t> page_table_;  // to keep track of pages
+  Replacer *replacer_;                               // to find an unpinned page for replacement
+  list<frame_id_t> free_list_;                       // to find a free page for replacement
+  recursive_mutex latch_;                            // to protect shared data structure
+};
+
+#endif  // MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
@@ -0,0 +1,67 @@
+#ifndef MINISQL_LRU_K_REPLACER_H
+#define MINISQL_LRU_K_REPLACER_H
+
+#include <list>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+#include "common/macros.h"
+
+using namespace std;
+
+/**
+ * LRUKReplacer implements the LRU-K replacement policy. The victim is the evictable frame whose K-th most recent
+ * access lies furthest in the past (the largest backward K-distance). Frames with fewer than K recorded accesses have
+ * an infinite distance and are evicted first, the one with the earliest access going first. A single sequential scan
+ * touches every page only once, so it cannot push out pages which are referenced repeatedly.
+ */
+class LRUKReplacer : public Replacer {
+ public:
+  /**
+   * Create a new LRUKReplacer.
+   * @param num_pages the maximum number of pages the LRUKReplacer will be required to store
+   * @param k the number of accesses remembered for every frame
+   */
+  explicit LRUKReplacer(size_t num_pages, size_t k = LRUK_REPLACER_K);
+
+  /**
+   * Destroys the LRUKReplacer.
+   */
+  ~LRUKReplacer() override;
+
+  bool Victim(frame_id_t *frame_id) override;
+
+  void Pin(frame_id_t frame_id) override;
+
+  void Unpin(frame_id_t frame_id) override;
+
+  size_t Size() override;
+
+  void RecordAccess(frame_id_t frame_id) override;
+
+  void Remove(frame_id_t frame_id) override;
+
+ private:
+  /** eviction order: frames with less than k accesses first, then by the oldest remembered access */
+  using EvictKey = std::tuple<bool, size_t, frame_id_t>;
+
+  struct FrameEntry {
+    list<size_t> history_;  // timestamps of the last k accesses, oldest first
+    bool evictable_{false};
+  };
+
+  EvictKey MakeKey(frame_id_t frame_id, const FrameEntry &entry) const {
+    return {entry.history_.size() >= k_, entry.history_.front(), frame_id};
+  }
+
+  size_t max_num_pages_;
+  size_t k_;
+  size_t current_timestamp_{0};
+  unordered_map<frame_id_t, FrameEntry> frames_;  // access history of every tracked frame
+  set<EvictKey> evictable_;                       // evictable frames in eviction order
+};
+
+#endif  // MINISQL_LRU_K_REPLACER_H
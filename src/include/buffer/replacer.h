@@ -5,6 +5,11 @@
 
 #include "common/config.h"
 
+/**
+ * Replacement policies the buffer pool can be configured with.
+ */
+enum class ReplacerType { kLRUReplacer = 0, kClockReplacer, kLRUKReplacer };
+
 /**
  * Replacer is an abstract class that tracks page usage.
  */
@@ -35,6 +40,18 @@ class Replacer {
 
   /** @return the number of elements in the replacer that can be victimized */
   virtual size_t Size() = 0;
+
+  /**
+   * Records that the page held by a frame has been accessed. Policies without access history ignore it.
+   * @param frame_id the id of the accessed frame
+   */
+  virtual void RecordAccess(__attribute__((unused)) frame_id_t frame_id) {}
+
+  /**
+   * Forgets a frame whose page left the buffer pool without being victimized, e.g. a deleted page.
+   * @param frame_id the id of the frame to remove
+   */
+  virtual void Remove(frame_id_t frame_id) { Pin(frame_id); }
 };
 
 #endif  // MINISQL_REPLACER_H
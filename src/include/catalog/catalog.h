@@ -52,7 +52,7 @@ class CatalogMeta {
     if (index_meta_pages_.find(index_id) == index_meta_pages_.end()) {
       return false;
     }
-    bpm->DeletePage(index_meta_pages_[index_id]);
+    bpm->FreePage(index_meta_pages_[index_id]);
     index_meta_pages_.erase(index_id);
     return true;
   }
@@ -77,7 +77,11 @@ class CatalogManager {
 
   ~CatalogManager();
 
-  dberr_t CreateTable(const std::string &table_name, TableSchema *schema, Transaction *txn, TableInfo *&table_info);
+  /**
+   * @param layout layout of the pages of the table, DB_FAILED if a row of the schema does not fit a pax page
+   */
+  dberr_t CreateTable(const std::string &table_name, TableSchema *schema, Transaction *txn, TableInfo *&table_info,
+                      TableLayout layout = TableLayout::kRow);
 
   dberr_t GetTable(const std::string &table_name, TableInfo *&table_info);
 
@@ -13,11 +13,37 @@ static constexpr int META_PAGE_ID = 0;          // physical page id of the disk
 static constexpr int CATALOG_META_PAGE_ID = 0;  // logical page id of the catalog meta data
 static constexpr int INDEX_ROOTS_PAGE_ID = 1;   // logical page id of the index roots
 
-static constexpr int PAGE_SIZE = 4096;                  // size of a data page in byte
-static constexpr int DEFAULT_BUFFER_POOL_SIZE = 20480;  // default size of buffer pool
+// the page size is a build option, see MINISQL_PAGE_SIZE in CMakeLists.txt
+#ifndef MINISQL_PAGE_SIZE
+#define MINISQL_PAGE_SIZE 4096
+#endif
+
+static constexpr int PAGE_SIZE = MINISQL_PAGE_SIZE;      // size of a data page in byte
+static constexpr int PAGE_CHECKSUM_SIZE = 4;             // trailing bytes of a page holding its checksum
+static constexpr int PAGE_USABLE_SIZE = PAGE_SIZE - PAGE_CHECKSUM_SIZE;  // bytes of a page usable by its contents
+static constexpr int DEFAULT_BUFFER_POOL_SIZE = 20480 * 4096 / PAGE_SIZE;  // default size of buffer pool, 80 MB
+static constexpr int DEFAULT_BUFFER_POOL_INSTANCES = 1;  // default number of buffer pool partitions
+static constexpr int DEFAULT_DISK_IO_WORKERS = 4;        // default number of disk scheduler worker threads
+static constexpr int LRUK_REPLACER_K = 2;                // number of accesses remembered by the LRU-K replacer
+static constexpr int DEFAULT_SCAN_RING_SIZE = 32;        // number of frames a bulk scan may recycle
+static constexpr int DEFAULT_READ_AHEAD_PAGES = 8;       // number of pages prefetched ahead of a chain scan
+static constexpr int DEFAULT_PAGE_RUN_SIZE = 8;          // contiguous pages a table heap or index reserves at once
+static constexpr int DEFAULT_INSERT_BATCH_SIZE = 256;    // rows an insert pushes into the table heap at once
+static constexpr int BULK_LOAD_CHUNK_SIZE = 1 << 20;     // bytes a bulk load reads from its file at once
+static constexpr int DEFAULT_ARENA_BLOCK_SIZE = 1 << 16;  // bytes of a block of a query memory arena
+static constexpr int DATA_CHUNK_CAPACITY = 1024;          // rows of a batch of the vectorized executors
+
+static constexpr int DEFAULT_BGWRITER_INTERVAL_MS = 50;        // sleep time of the background writer between rounds
+static constexpr double DEFAULT_BGWRITER_CLEAN_TARGET = 0.25;  // fraction of frames the writer keeps clean
+static constexpr int DEFAULT_BGWRITER_MAX_PAGES = 64;          // max pages one instance writes per round
+static constexpr int DEFAULT_CHECKPOINT_INTERVAL_MS = 5000;    // time between two checkpoints, 0 disables them
+
+static_assert(PAGE_SIZE >= 4096 && PAGE_SIZE <= 32768 && (PAGE_SIZE & (PAGE_SIZE - 1)) == 0,
+              "MINISQL_PAGE_SIZE must be 4096, 8192, 16384 or 32768");
 
 static constexpr uint32_t FIELD_NULL_LEN = UINT32_MAX;
-static constexpr uint32_t VARCHAR_MAX_LEN = PAGE_SIZE / 2;  // max length of varchar
+static constexpr uint32_t VARCHAR_MAX_LEN = 1 << 16;                 // max length of varchar
+static constexpr uint32_t CHAR_OVERFLOW_THRESHOLD = PAGE_SIZE / 8;  // longer char values go to overflow pages
 
 // static std::string DB_META_FILE = "minisql.meta.db";
 
@@ -0,0 +1,23 @@
+#ifndef MINISQL_CRC32C_H
+#define MINISQL_CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * CRC32C (Castagnoli) of a buffer, continuing the checksum `crc` of the data before it. Runs on the SSE4.2 crc32
+ * instruction when the CPU has it, on the table driven implementation otherwise.
+ */
+uint32_t Crc32c(const char *data, size_t length, uint32_t crc = 0);
+
+/**
+ * Table driven CRC32C (slicing-by-8), the fallback of Crc32c on CPUs without SSE4.2.
+ */
+uint32_t Crc32cSoftware(const char *data, size_t length, uint32_t crc = 0);
+
+/**
+ * @return whether Crc32c runs on the crc32 instruction
+ */
+bool Crc32cIsHardwareAccelerated();
+
+#endif  // MINISQL_CRC32C_H
@@ -0,0 +1,70 @@
+#ifndef MINISQL_MEMORY_ARENA_H
+#define MINISQL_MEMORY_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+/**
+ * Snapshot of the counters of a memory arena.
+ */
+struct ArenaStats {
+  uint64_t allocations_{0};      // objects carved from the arena
+  uint64_t bytes_allocated_{0};  // bytes asked for, alignment padding excluded
+  uint64_t blocks_{0};           // blocks the arena allocated from the heap
+  uint64_t peak_bytes_{0};       // most bytes the blocks of the arena held at once
+};
+
+/**
+ * Bump allocator the short-lived objects of a query are carved from. Objects are never freed one by one, the memory
+ * is given back in bulk by Reset() or when the arena is destroyed. The destructors of the objects are not run, so an
+ * object placed in an arena must not own heap memory. Not thread safe.
+ */
+class MemoryArena {
+ public:
+  explicit MemoryArena(size_t block_size = DEFAULT_ARENA_BLOCK_SIZE) : block_size_(block_size) {}
+
+  ~MemoryArena() = default;
+
+  DISALLOW_COPY_AND_MOVE(MemoryArena);
+
+  void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  /** Construct an object in the arena */
+  template <typename T, typename... Args>
+  T *New(Args &&...args) {
+    return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  /** @return a copy of `len` bytes in the arena */
+  char *CopyChars(const char *data, size_t len);
+
+  /** Give back the memory of every object of the arena, one block is kept for the next ones */
+  void Reset();
+
+  ArenaStats GetStats() const { return stats_; }
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data_;
+    size_t size_;
+  };
+
+  /** @return a new block of `size` bytes */
+  char *AddBlock(size_t size);
+
+  size_t block_size_;
+  std::vector<Block> blocks_;
+  char *cur_{nullptr};  // next free byte of the block objects are bumped from
+  char *end_{nullptr};
+  uint64_t held_bytes_{0};
+  ArenaStats stats_;
+};
+
+#endif  // MINISQL_MEMORY_ARENA_H
@@ -0,0 +1,79 @@
+#ifndef MINISQL_STATISTICS_H
+#define MINISQL_STATISTICS_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Storage layer counters. The live counters are relaxed atomics bumped on the hot path, the plain structs below are
+ * snapshots of them handed out to benchmarks and SHOW STATUS. A snapshot is not taken atomically as a whole.
+ */
+
+/**
+ * Snapshot of the buffer pool counters.
+ */
+struct BufferPoolStats {
+  uint64_t fetch_hits_{0};         // FetchPage found the page resident
+  uint64_t fetch_misses_{0};       // FetchPage had to read the page
+  uint64_t new_pages_{0};          // pages created by NewPage
+  uint64_t evictions_{0};          // resident pages replaced to make room
+  uint64_t dirty_write_backs_{0};  // dirty victims written back by foreground requests
+  uint64_t pages_flushed_{0};      // pages written by FlushPage, the background writer and checkpoints
+  uint64_t prefetches_{0};         // reads started by Prefetch
+};
+
+/**
+ * Snapshot of the disk manager counters.
+ */
+struct DiskStats {
+  uint64_t reads_{0};              // physical pages read, meta and bitmap pages included
+  uint64_t writes_{0};             // physical pages written, meta and bitmap pages included
+  uint64_t bytes_read_{0};         // bytes read from the database file
+  uint64_t bytes_written_{0};      // bytes written to the database file
+  uint64_t flushes_{0};            // fsyncs of the database file
+  uint64_t allocations_{0};        // pages allocated
+  uint64_t deallocations_{0};      // pages deallocated
+  uint64_t checksum_failures_{0};  // pages read which failed their checksum
+};
+
+/**
+ * Live counters of one table or index. The buffer pool charges fetches made inside a StatsScope of the object to it.
+ */
+struct AccessStats {
+  std::atomic<uint64_t> fetch_hits_{0};
+  std::atomic<uint64_t> fetch_misses_{0};
+
+  uint64_t GetFetchHits() const { return fetch_hits_.load(std::memory_order_relaxed); }
+
+  uint64_t GetFetchMisses() const { return fetch_misses_.load(std::memory_order_relaxed); }
+};
+
+/**
+ * StatsScope makes a table or index the owner of the page fetches of the current thread until it goes out of scope.
+ * Scopes nest, the innermost one wins.
+ */
+class StatsScope {
+ public:
+  explicit StatsScope(AccessStats *stats) : prev_(current_) { current_ = stats; }
+
+  ~StatsScope() { current_ = prev_; }
+
+  StatsScope(const StatsScope &) = delete;
+  StatsScope &operator=(const StatsScope &) = delete;
+
+  /** @return the counters of the object the current thread works on, nullptr if none */
+  static AccessStats *Current() { return current_; }
+
+ private:
+  AccessStats *prev_;
+  inline static thread_local AccessStats *current_{nullptr};
+};
+
+/**
+ * Bump a live counter.
+ */
+inline void StatsAdd(std::atomic<uint64_t> &counter, uint64_t value = 1) {
+  counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+#endif  // MINISQL_STATISTICS_H
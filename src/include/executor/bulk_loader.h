@@ -0,0 +1,80 @@
+#ifndef MINISQL_BULK_LOADER_H
+#define MINISQL_BULK_LOADER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/indexes.h"
+#include "catalog/table.h"
+#include "executor/execute_context.h"
+#include "record/row.h"
+
+/**
+ * BulkLoader loads a CSV file into a table, it backs `COPY table FROM "file"`.
+ *
+ * The file is read in chunks of BULK_LOAD_CHUNK_SIZE bytes and each record is parsed straight into the fields of the
+ * table schema, the rows go into the table heap DEFAULT_INSERT_BATCH_SIZE at a time. The indexes are not touched while
+ * the heap fills up: their keys are collected, sorted once at the end, checked against the unique constraints and
+ * inserted in key order. A load inserts either every record of the file or, on a malformed record or a violated
+ * constraint, none of them.
+ *
+ * Format: one record per line, the fields separated by ','. A field enclosed in double quotes may hold ',', line
+ * breaks and "" for a quote. An empty unquoted field is NULL.
+ */
+class BulkLoader {
+ public:
+  BulkLoader(ExecuteContext *exec_ctx, TableInfo *table_info);
+
+  /**
+   * Load every record of a file into the table.
+   * @return the number of rows loaded, a string describing the error is thrown on failure
+   */
+  size_t Load(const std::string &file_name);
+
+ private:
+  /**
+   * Parse the records of [begin, end) and queue them for insertion.
+   * @param eof whether the file ends at `end`, otherwise the last record may be cut by the chunk
+   * @return the beginning of the first incomplete record, `end` if there is none
+   */
+  const char *ParseRecords(const char *begin, const char *end, bool eof);
+
+  /**
+   * Parse one record, the line break excluded, into a row.
+   */
+  void ParseRecord(const char *begin, const char *end);
+
+  /**
+   * Convert the text of a field to a value of its column, NULL if `text` is nullptr.
+   */
+  void AppendField(uint32_t column_index, const char *text, size_t len, std::vector<Field> &fields);
+
+  /** Insert the queued rows into the table heap and collect their keys */
+  void Flush();
+
+  /** Check the collected keys against the unique constraints, then insert them into the indexes */
+  void BuildIndexes();
+
+  /** Remove the rows this load inserted so far */
+  void Rollback();
+
+  /** @return `message` prefixed with the line of the record being parsed */
+  std::string ErrorAt(const std::string &message) const;
+
+  ExecuteContext *exec_ctx_;
+  TableInfo *table_info_;
+  std::vector<IndexInfo *> indexes_;
+  /** Rows parsed but not inserted yet */
+  std::vector<Row> batch_;
+  /** Rows inserted by this load */
+  std::vector<RowId> inserted_;
+  /** The keys of the inserted rows in each index */
+  std::vector<std::vector<std::pair<Row, RowId>>> keys_;
+  /** Line of the file the record being parsed starts at */
+  size_t line_no_{1};
+  /** Unquoted copy of the field being parsed */
+  std::string scratch_;
+};
+
+#endif  // MINISQL_BULK_LOADER_H
@@ -0,0 +1,87 @@
+#ifndef MINISQL_COMPILED_PREDICATE_H
+#define MINISQL_COMPILED_PREDICATE_H
+
+#include <memory>
+#include <vector>
+
+#include "executor/data_chunk.h"
+#include "planner/expressions/abstract_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "record/row.h"
+
+struct PredicateNode;
+
+/**
+ * @return whether the row satisfies the node
+ */
+using PredicateKernel = bool (*)(const PredicateNode &node, const Row &row);
+
+/**
+ * Select the rows of a chunk satisfying the node among `count` ones.
+ * @param selection the indexes of the rows tested, in ascending order
+ * @param[out] out the indexes of the rows satisfying the node, in ascending order; it may be `selection` itself
+ * @return the number of rows satisfying the node
+ */
+using BatchPredicateKernel = uint32_t (*)(const PredicateNode &node, const DataChunk &chunk, const uint32_t *selection,
+                                          uint32_t count, uint32_t *out);
+
+/**
+ * A node of a compiled predicate, run by its kernel.
+ */
+struct PredicateNode {
+  PredicateKernel kernel_{nullptr};
+  BatchPredicateKernel batch_kernel_{nullptr};
+  /** The column a comparison reads */
+  uint32_t column_{0};
+  /** The constant the column is compared with */
+  Field constant_{TypeId::kTypeInvalid};
+  /** The operands of AND and OR */
+  const PredicateNode *left_{nullptr};
+  const PredicateNode *right_{nullptr};
+  /** The expression of the node, evaluated as is by the kernel of an expression that is not compiled */
+  const AbstractExpression *expression_{nullptr};
+  /** Scratch of the batch kernels: the rows satisfying each operand of OR, and the row an expression is evaluated on */
+  mutable std::vector<uint32_t> left_selection_;
+  mutable std::vector<uint32_t> right_selection_;
+  mutable Row row_;
+};
+
+/**
+ * A predicate compiled once per query from its expression tree into a tree of kernels. A comparison of a column with a
+ * constant runs a kernel generated for the type of the column and the operator, AND and OR run the kernels of their
+ * operands, so that testing a row compares no string, does not dispatch through Type and builds no Field. Every
+ * kernel also has a batch form testing the selected rows of a DataChunk in one call. Any other expression is
+ * evaluated as is.
+ *
+ * A row satisfies the predicate when the expression evaluates to 1: a comparison with NULL never holds, and AND and OR
+ * are those of booleans.
+ */
+class CompiledPredicate {
+ public:
+  /** A predicate every row satisfies */
+  CompiledPredicate() = default;
+
+  /**
+   * @param expression the predicate, nullptr for one every row satisfies; it must outlive the compiled predicate
+   */
+  explicit CompiledPredicate(const AbstractExpressionRef &expression);
+
+  inline bool Evaluate(const Row &row) const { return root_ == nullptr || root_->kernel_(*root_, row); }
+
+  /**
+   * Narrow the selection vector of a chunk to the rows satisfying the predicate, each kernel runs over the whole batch.
+   * The columns of the chunk are those the columns of the predicate refer to.
+   */
+  void Select(DataChunk &chunk) const;
+
+ private:
+  const PredicateNode *Compile(const AbstractExpressionRef &expression);
+
+  /** Pick specialized kernels for a comparison, the node keeps the fallback kernels if there are none */
+  static void CompileComparison(const ComparisonExpression &comparison, PredicateNode *node);
+
+  std::vector<std::unique_ptr<PredicateNode>> nodes_;
+  const PredicateNode *root_{nullptr};
+};
+
+#endif  // MINISQL_COMPILED_PREDICATE_H
@@ -0,0 +1,131 @@
+#ifndef MINISQL_DATA_CHUNK_H
+#define MINISQL_DATA_CHUNK_H
+
+#include <vector>
+
+#include "common/config.h"
+#include "common/memory_arena.h"
+#include "common/rowid.h"
+#include "record/row.h"
+
+/**
+ * A CHAR value of a column vector, its bytes lie in the memory of the chunk, or of the chunk it was projected from.
+ */
+struct CharValue {
+  const char *data_;
+  uint32_t len_;
+};
+
+/**
+ * The values of one column of a batch in a contiguous array of its type: int32_t for INT, float for FLOAT and
+ * CharValue for CHAR, with one NULL flag per value. The value of a NULL entry is undefined.
+ */
+class ColumnVector {
+ public:
+  void Init(TypeId type, uint32_t capacity);
+
+  inline TypeId GetType() const { return type_; }
+
+  template <typename T>
+  inline T *GetData() {
+    return reinterpret_cast<T *>(data_.data());
+  }
+
+  template <typename T>
+  inline const T *GetData() const {
+    return reinterpret_cast<const T *>(data_.data());
+  }
+
+  /** @return the NULL flags of the values, 1 for NULL */
+  inline uint8_t *GetNulls() { return nulls_.data(); }
+
+  inline const uint8_t *GetNulls() const { return nulls_.data(); }
+
+  inline bool IsNull(uint32_t index) const { return nulls_[index] != 0; }
+
+  /** @return the bytes a value of the type takes in a column vector */
+  static uint32_t GetValueWidth(TypeId type);
+
+ private:
+  TypeId type_{TypeId::kTypeInvalid};
+  std::vector<char> data_;
+  std::vector<uint8_t> nulls_;
+};
+
+/**
+ * A batch of up to DATA_CHUNK_CAPACITY rows stored column by column, the unit the vectorized executors pass each
+ * other. The rows of the batch are those of its selection vector, in order: a filter narrows the selection instead of
+ * moving the values, the others stay in the chunk but are skipped.
+ */
+class DataChunk {
+ public:
+  DataChunk() = default;
+
+  DISALLOW_COPY_AND_MOVE(DataChunk);
+
+  /**
+   * Lay out the chunk for columns of the given types, the memory is allocated once and reused by every batch
+   */
+  void Init(const std::vector<TypeId> &types, uint32_t capacity = DATA_CHUNK_CAPACITY);
+
+  /** Drop the rows of the chunk and give back the memory of its CHAR values, the layout is kept */
+  void Reset();
+
+  inline uint32_t GetColumnCount() const { return columns_.size(); }
+
+  inline uint32_t GetCapacity() const { return capacity_; }
+
+  /** @return the number of rows stored, selected or not */
+  inline uint32_t GetSize() const { return size_; }
+
+  /** @return whether no row can be appended, a chunk not laid out yet is not full */
+  inline bool IsFull() const { return capacity_ > 0 && size_ == capacity_; }
+
+  /** @return the number of rows in the selection vector */
+  inline uint32_t GetCount() const { return count_; }
+
+  /** @return the index of the i-th selected row */
+  inline uint32_t GetSelection(uint32_t i) const { return selection_[i]; }
+
+  /** @return the selection vector, the indexes of the selected rows in ascending order */
+  inline uint32_t *GetSelectionVector() { return selection_.data(); }
+
+  /** Keep the first `count` entries of the selection vector */
+  inline void SetCount(uint32_t count) { count_ = count; }
+
+  inline ColumnVector &GetColumn(uint32_t column) { return columns_[column]; }
+
+  inline const ColumnVector &GetColumn(uint32_t column) const { return columns_[column]; }
+
+  inline RowId GetRowId(uint32_t index) const { return rids_[index]; }
+
+  /**
+   * Append a row and select it, its CHAR values are copied into the chunk. The first row of a batch lays out the chunk
+   * for the types of its fields if they are not those of the columns.
+   */
+  void AppendRow(const Row &row, RowId rid);
+
+  /**
+   * Overwrite `row` in place with a row of the chunk, as Row::SetField does
+   * @param index the index of the row in the chunk, not in the selection vector
+   */
+  void GetRow(uint32_t index, Row *row) const;
+
+  /**
+   * Make this chunk the projection of `source` on some of its columns, selection included. The values are copied but
+   * the bytes of the CHAR values are those of `source`, valid until it is reset.
+   */
+  void Project(const DataChunk &source, const std::vector<uint32_t> &columns);
+
+ private:
+  std::vector<ColumnVector> columns_;
+  std::vector<RowId> rids_;
+  std::vector<uint32_t> selection_;
+  uint32_t capacity_{0};
+  uint32_t size_{0};
+  uint32_t count_{0};
+  /** The bytes of the CHAR values appended */
+  MemoryArena arena_;
+};
+
+#endif  // MINISQL_DATA_CHUNK_H
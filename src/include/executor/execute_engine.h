@@ -40,6 +40,9 @@ class ExecuteEngine {
 
   void ExecuteInformation(dberr_t result);
 
+  /** @return the counters of the memory arena of the last plan executed */
+  ArenaStats GetLastQueryArenaStats() const { return last_query_arena_; }
+
  private:
   static std::unique_ptr<AbstractExecutor> CreateExecutor(ExecuteContext *exec_ctx, const AbstractPlanNodeRef &plan);
 
@@ -63,6 +66,8 @@ class ExecuteEngine {
 
   dberr_t ExecuteDropIndex(pSyntaxNode ast, ExecuteContext *context);
 
+  dberr_t ExecuteShowStatus(pSyntaxNode ast, ExecuteContext *context);
+
   dberr_t ExecuteTrxBegin(pSyntaxNode ast, ExecuteContext *context);
 
   dberr_t ExecuteTrxCommit(pSyntaxNode ast, ExecuteContext *context);
@@ -71,11 +76,14 @@ class ExecuteEngine {
 
   dberr_t ExecuteExecfile(pSyntaxNode ast, ExecuteContext *context);
 
+  dberr_t ExecuteCopy(pSyntaxNode ast, ExecuteContext *context);
+
   dberr_t ExecuteQuit(pSyntaxNode ast, ExecuteContext *context);
 
  private:
   std::unordered_map<std::string, DBStorageEngine *> dbs_; /** all opened databases */
   std::string current_db_;                                 /** current database */
+  ArenaStats last_query_arena_;                            /** memory arena of the last plan, for SHOW STATUS */
 };
 
 #endif  // MINISQL_EXECUTE_ENGINE_H
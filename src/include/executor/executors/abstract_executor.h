@@ -1,11 +1,15 @@
 #ifndef MINISQL_ABSTRACT_EXECUTOR_H
 #define MINISQL_ABSTRACT_EXECUTOR_H
 
+#include "executor/data_chunk.h"
 #include "executor/execute_context.h"
 /**
- * The AbstractExecutor implements the Volcano row-at-a-time iterator model.
- * This is the base class from which all executors in the execution engine
- * inherit, and defines the minimal interface that all executors support.
+ * The AbstractExecutor implements the Volcano iterator model, a row at a time with Next() or a batch at a time with
+ * NextBatch(). This is the base class from which all executors in the execution engine inherit, and defines the
+ * minimal interface that all executors support.
+ *
+ * By default NextBatch() is an adapter filling the chunk from Next(). An executor producing batches natively overrides
+ * it and serves Next() from its batches with NextFromBatch().
  */
 class AbstractExecutor {
  public:
@@ -32,6 +36,20 @@ class AbstractExecutor {
    */
   virtual bool Next(Row *row, RowId *rid) = 0;
 
+  /**
+   * Yield the next batch of rows from this executor, the rows of the chunk are those of its selection vector.
+   * @param[out] chunk The next batch, its CHAR values are valid until the next call
+   * @return `true` if a batch with at least one selected row was produced, `false` if there are no more rows
+   */
+  virtual bool NextBatch(DataChunk &chunk) {
+    chunk.Reset();
+    RowId rid;
+    while (!chunk.IsFull() && Next(&adapter_row_, &rid)) {
+      chunk.AppendRow(adapter_row_, rid);
+    }
+    return chunk.GetCount() > 0;
+  }
+
   /** @return The schema of the rows that this executor produces */
   virtual const Schema *GetOutputSchema() const = 0;
 
@@ -39,8 +57,38 @@ class AbstractExecutor {
   ExecuteContext *GetExecutorContext() { return exec_ctx_; }
 
  protected:
+  /**
+   * Next() of an executor producing batches natively: the rows are taken one by one out of the batches of NextBatch()
+   */
+  bool NextFromBatch(Row *row, RowId *rid) {
+    while (batch_cursor_ == batch_.GetCount()) {
+      batch_cursor_ = 0;
+      if (!NextBatch(batch_)) {
+        batch_.Reset();
+        return false;
+      }
+    }
+    uint32_t index = batch_.GetSelection(batch_cursor_++);
+    batch_.GetRow(index, row);
+    *rid = batch_.GetRowId(index);
+    return true;
+  }
+
+  /** Forget the rows of the current batch of NextFromBatch(), for an executor initialized again */
+  void ResetBatch() {
+    batch_.Reset();
+    batch_cursor_ = 0;
+  }
+
   /** The executor context in which the executor runs */
   ExecuteContext *exec_ctx_;
+
+ private:
+  /** The row the NextBatch() adapter reads from Next() */
+  Row adapter_row_;
+  /** The batch NextFromBatch() takes its rows from */
+  DataChunk batch_;
+  uint32_t batch_cursor_{0};
 };
 
 #endif  // MINISQL_ABSTRACT_EXECUTOR_H
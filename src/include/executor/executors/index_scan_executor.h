@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "executor/compiled_predicate.h"
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/index_scan_plan.h"
@@ -32,6 +33,13 @@ class IndexScanExecutor : public AbstractExecutor {
    */
   bool Next(Row *row, RowId *rid) override;
 
+  /**
+   * Yield the next batch of the index scan, the predicate and the projection run over whole batches.
+   * @param[out] chunk The next batch, its CHAR values are valid until the next call
+   * @return `true` if a batch was produced, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk &chunk) override;
+
   /** @return The output schema for the sequential scan */
   const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
 
@@ -48,4 +56,14 @@ class IndexScanExecutor : public AbstractExecutor {
   vector<RowId>::iterator it_;
   Schema* original_schema_;
   TableInfo* table_;
+  /** Column of the table behind each column of the output */
+  std::vector<uint32_t> output_columns_;
+  /** The predicate of the plan, compiled by Init */
+  CompiledPredicate predicate_;
+  /** A batch of tuples with a column per column of the table */
+  DataChunk scan_chunk_;
+  /** Memory of the current tuple, given back before the next one is read */
+  MemoryArena row_arena_;
+  /** The current tuple */
+  Row tuple_{&row_arena_};
 };
\ No newline at end of file
@@ -5,6 +5,8 @@
 #ifndef MINISQL_INSERT_EXECUTOR_H
 #define MINISQL_INSERT_EXECUTOR_H
 
+#include <vector>
+
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/insert_plan.h"
@@ -12,7 +14,9 @@
 /**
  * InsertExecutor executes an insert on a table.
  *
- * Inserted values are always pulled from a child executor.
+ * Inserted values are always pulled from a child executor, in batches of DEFAULT_INSERT_BATCH_SIZE rows. A batch is
+ * checked against the unique indexes as a whole, then goes into the table heap at once and into each index in key
+ * order. A batch violating a constraint is not inserted at all, the batches before it stay.
  */
 class InsertExecutor : public AbstractExecutor {
  public:
@@ -42,9 +46,20 @@ class InsertExecutor : public AbstractExecutor {
   const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
 
  private:
+  /**
+   * Pull the next batch of rows from the child and insert it.
+   * @return false if the child has no more rows
+   */
+  bool InsertBatch();
+
   /** The insert plan node to be executed*/
   const InsertPlanNode *plan_;
   std::unique_ptr<AbstractExecutor> child_executor_;
+  TableInfo *table_info_{nullptr};
+  std::vector<IndexInfo *> indexes_;
+  /** The rows inserted by the current batch, yielded one by one */
+  std::vector<Row> batch_;
+  size_t cursor_{0};
 };
 
 #endif  // MINISQL_INSERT_EXECUTOR_H
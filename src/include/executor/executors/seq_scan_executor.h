@@ -7,6 +7,7 @@
 
 #include <vector>
 
+#include "executor/compiled_predicate.h"
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/seq_scan_plan.h"
@@ -34,6 +35,13 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   bool Next(Row *row, RowId *rid) override;
 
+  /**
+   * Yield the next batch of the sequential scan, the predicate and the projection run over whole batches.
+   * @param[out] chunk The next batch, its CHAR values are valid until the next call
+   * @return `true` if a batch was produced, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk &chunk) override;
+
   /** @return The output schema for the sequential scan */
   const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
 
@@ -44,6 +52,20 @@ class SeqScanExecutor : public AbstractExecutor {
   TableIterator it_;
   TableHeap* tableHeap_;
   Schema* original_schema_;
+  /** The scan recycles a small ring of frames instead of flushing the buffer pool */
+  BufferAccessStrategy strategy_;
+  /** Columns of the table the output and the predicate read, the only ones taken from a pax page */
+  std::vector<uint32_t> scan_columns_;
+  /** Column of the table behind each column of the output */
+  std::vector<uint32_t> output_columns_;
+  /** The predicate of the plan, compiled by Init */
+  CompiledPredicate predicate_;
+  /** A batch of tuples with a column per column of the table, only the scanned ones are read */
+  DataChunk scan_chunk_;
+  /** Memory of the current tuple, given back before the next one is read */
+  MemoryArena row_arena_;
+  /** The current tuple */
+  Row scan_row_{&row_arena_};
 };
 
 #endif  // MINISQL_SEQ_SCAN_EXECUTOR_H
@@ -0,0 +1,46 @@
+#ifndef MINISQL_INDEX_KEY_H
+#define MINISQL_INDEX_KEY_H
+
+#include <vector>
+
+#include "catalog/indexes.h"
+#include "record/row.h"
+
+/**
+ * Helpers shared by the executors which maintain indexes over many rows at once: the keys of a batch are built with
+ * MakeIndexKey and sorted with IndexKeyLess, so that the unique checks and the inserts walk each tree in key order.
+ */
+
+/**
+ * @return the key of `row` in an index
+ */
+inline Row MakeIndexKey(IndexInfo *index, const Row &row) {
+  std::vector<Field> key_fields;
+  for (auto column : index->GetIndexKeySchema()->GetColumns()) {
+    key_fields.emplace_back(*row.GetField(column->GetTableInd()));
+  }
+  return Row(key_fields);
+}
+
+inline bool IndexKeyLess(const Row &a, const Row &b) {
+  for (size_t i = 0; i < a.GetFieldCount(); i++) {
+    if (a.GetField(i)->CompareLessThan(*b.GetField(i)) == CmpBool::kTrue) {
+      return true;
+    }
+    if (a.GetField(i)->CompareGreaterThan(*b.GetField(i)) == CmpBool::kTrue) {
+      return false;
+    }
+  }
+  return false;
+}
+
+inline bool IndexKeyEquals(const Row &a, const Row &b) { return !IndexKeyLess(a, b) && !IndexKeyLess(b, a); }
+
+/**
+ * @return whether the index enforces a primary key or a unique constraint
+ */
+inline bool IsUniqueIndex(IndexInfo *index) {
+  return index->GetIndexName() == "PRIMARY_KEY_" || index->GetIndexName().find("__Unique") == 0;
+}
+
+#endif  // MINISQL_INDEX_KEY_H
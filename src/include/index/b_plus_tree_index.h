@@ -17,6 +17,8 @@ class BPlusTreeIndex : public Index {
 
   dberr_t Destroy() override;
 
+  AccessStats *GetAccessStats() override { return container_.GetAccessStats(); }
+
   IndexIterator GetBeginIterator();
 
   IndexIterator GetBeginIterator(GenericKey *key);
@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "common/dberr.h"
+#include "common/statistics.h"
 #include "record/row.h"
 #include "transaction/transaction.h"
 
@@ -22,6 +23,11 @@ class Index {
 
   virtual dberr_t Destroy() = 0;
 
+  /**
+   * @return the buffer pool counters charged to this index, nullptr if it keeps none
+   */
+  virtual AccessStats *GetAccessStats() { return nullptr; }
+
  protected:
   index_id_t index_id_;
   IndexSchema *key_schema_;
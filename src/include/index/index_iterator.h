@@ -1,6 +1,7 @@
 #ifndef MINISQL_INDEX_ITERATOR_H
 #define MINISQL_INDEX_ITERATOR_H
 
+#include "common/statistics.h"
 #include "page/b_plus_tree_leaf_page.h"
 
 class IndexIterator {
@@ -10,7 +11,7 @@ class IndexIterator {
   // you may define your own constructor based on your member variables
   explicit IndexIterator();
 
-  explicit IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index = 0);
+  explicit IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index = 0, AccessStats *stats = nullptr);
 
   ~IndexIterator();
 
@@ -31,6 +32,7 @@ class IndexIterator {
   LeafPage *page{nullptr};
   int item_index{0};
   BufferPoolManager *buffer_pool_manager{nullptr};
+  AccessStats *stats_{nullptr};  // counters of the tree the iterator walks
   // add your own private member variables here
 };
 
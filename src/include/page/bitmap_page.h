@@ -20,6 +20,13 @@ class BitmapPage {
    */
   bool AllocatePage(uint32_t &page_offset);
 
+  /**
+   * Allocate `count` contiguous pages, the search starts at the next free page.
+   * @param page_offset Index in extent of the first page allocated.
+   * @return true if a free run of `count` pages was found and allocated.
+   */
+  bool AllocatePages(uint32_t count, uint32_t &page_offset);
+
   /**
    * @return true if successfully de-allocate a page.
    */
@@ -49,6 +56,11 @@ class BitmapPage {
    */
   void UpdateNextFreePage();
 
+  /**
+   * @return true if a run of `count` free pages starts in [from, GetMaxSupportedSize()), its start in page_offset
+   */
+  bool FindFreeRun(uint32_t from, uint32_t count, uint32_t &page_offset) const;
+
   /** Note: need to update if modify page structure. */
   static constexpr size_t MAX_CHARS = PageSize - 2 * sizeof(uint32_t);
 
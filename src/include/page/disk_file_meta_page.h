@@ -5,10 +5,29 @@
 
 #include "page/bitmap_page.h"
 
-static constexpr page_id_t MAX_VALID_PAGE_ID = (PAGE_SIZE - 8) / 4 * BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
+static constexpr page_id_t MAX_VALID_PAGE_ID =
+    (PAGE_USABLE_SIZE - 16) / 4 * BitmapPage<PAGE_USABLE_SIZE>::GetMaxSupportedSize();
 
+static constexpr uint32_t DISK_FILE_MAGIC_NUM = 0x4D53514C;  // "MSQL"
+
+/**
+ * The first physical page of a database file. The header records the page size the file was written with, since a
+ * build with another page size cannot make sense of the file.
+ */
 class DiskFileMetaPage {
  public:
+  /** Stamp the header of a new database file. */
+  void Init() {
+    magic_num_ = DISK_FILE_MAGIC_NUM;
+    page_size_ = PAGE_SIZE;
+  }
+
+  /** @return whether the meta page was never written, i.e. the file is new */
+  bool IsNew() const { return magic_num_ == 0 && page_size_ == 0 && num_allocated_pages_ == 0; }
+
+  /** @return whether the file was written by a build with the same page size */
+  bool IsCompatible() const { return magic_num_ == DISK_FILE_MAGIC_NUM && page_size_ == PAGE_SIZE; }
+
   uint32_t GetExtentNums() { return num_extents_; }
 
   uint32_t GetAllocatedPages() { return num_allocated_pages_; }
@@ -21,6 +40,8 @@ class DiskFileMetaPage {
   }
 
  public:
+  uint32_t magic_num_{0};
+  uint32_t page_size_{0};
   uint32_t num_allocated_pages_{0};
   uint32_t num_extents_{0};  // each extent consists with a bit map and BIT_MAP_SIZE pages
   uint32_t extent_used_page_[0];
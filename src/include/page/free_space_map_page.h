@@ -0,0 +1,78 @@
+#ifndef MINISQL_FREE_SPACE_MAP_PAGE_H
+#define MINISQL_FREE_SPACE_MAP_PAGE_H
+
+#include <algorithm>
+
+#include "common/config.h"
+
+/**
+ * Free space map of a table heap: the approximate free bytes of every table page, one byte per page, so that inserts
+ * go straight to a page with room instead of walking the page chain. A table with more pages than one map page holds
+ * chains further map pages. Entries are appended in the order the table pages are linked, so the last valid entry
+ * is the tail of the chain.
+ *
+ * The free bytes are stored as a category, i.e. rounded down to a multiple of CATEGORY_SIZE, a page of category c
+ * has at least c * CATEGORY_SIZE bytes free.
+ *
+ * Format (size in byte):
+ *  -------------------------------------------------------------------------------------------------
+ * | NextPageId (4) | EntryCount (4) | PageId_1 (4) | ... | PageId_n (4) | Category_1 (1) | ... |
+ *  -------------------------------------------------------------------------------------------------
+ */
+class FreeSpaceMapPage {
+ public:
+  void Init();
+
+  page_id_t GetNextPageId() const { return next_page_id_; }
+
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  uint32_t GetEntryCount() const { return entry_count_; }
+
+  bool IsFull() const { return entry_count_ >= MAX_ENTRY_COUNT; }
+
+  /**
+   * @return slot of the new entry
+   */
+  uint32_t Append(page_id_t page_id, uint8_t category);
+
+  /**
+   * Drop the entry of a page which no longer belongs to the table, the slot is left empty.
+   */
+  void Remove(uint32_t slot);
+
+  /**
+   * @return the table page of the entry, INVALID_PAGE_ID if the slot was removed
+   */
+  page_id_t GetPageId(uint32_t slot) const { return page_ids_[slot]; }
+
+  uint8_t GetCategory(uint32_t slot) const { return categories_[slot]; }
+
+  void SetCategory(uint32_t slot, uint8_t category) { categories_[slot] = category; }
+
+  /**
+   * @return the category of a page with `free_bytes` free, rounded down
+   */
+  static uint8_t ToCategory(uint32_t free_bytes) {
+    return std::min<uint32_t>(free_bytes / CATEGORY_SIZE, MAX_CATEGORY);
+  }
+
+  /**
+   * @return the least category guaranteeing `bytes` free, may exceed MAX_CATEGORY
+   */
+  static uint32_t CategoryFor(uint32_t bytes) { return (bytes + CATEGORY_SIZE - 1) / CATEGORY_SIZE; }
+
+  static constexpr uint32_t MAX_CATEGORY = 255;
+  static constexpr uint32_t CATEGORY_SIZE = PAGE_SIZE / (MAX_CATEGORY + 1);
+  static constexpr uint32_t MAX_ENTRY_COUNT = (PAGE_USABLE_SIZE - 8) / (sizeof(page_id_t) + sizeof(uint8_t));
+
+ private:
+  page_id_t next_page_id_;
+  uint32_t entry_count_;
+  page_id_t page_ids_[MAX_ENTRY_COUNT];
+  uint8_t categories_[MAX_ENTRY_COUNT];
+};
+
+static_assert(sizeof(FreeSpaceMapPage) <= PAGE_USABLE_SIZE, "Free space map page exceeds the page.");
+
+#endif  // MINISQL_FREE_SPACE_MAP_PAGE_H
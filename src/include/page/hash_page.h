@@ -70,7 +70,7 @@ class HashPage{
   [[maybe_unused]] page_id_t page_id_; // 4
   [[maybe_unused]] page_id_t pre_page_id_{INVALID_PAGE_ID}; // 4
   [[maybe_unused]] page_id_t next_page_id_{INVALID_PAGE_ID}; // 4
-  char data_[PAGE_SIZE - HASH_PAGE_HEADER_SIZE];
+  char data_[PAGE_USABLE_SIZE - HASH_PAGE_HEADER_SIZE];
 };
 
 #endif  // MINISQL_HASH_PAGE_H
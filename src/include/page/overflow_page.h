@@ -0,0 +1,39 @@
+#ifndef MINISQL_OVERFLOW_PAGE_H
+#define MINISQL_OVERFLOW_PAGE_H
+
+#include <cstring>
+
+#include "common/config.h"
+
+/**
+ * Overflow page: a piece of a CHAR value too long to be stored in its row. The pieces of a value are chained in
+ * order, the row keeps the length of the value and the first page of the chain.
+ *
+ * Format (size in byte):
+ *  ------------------------------------------
+ * | NextPageId (4) | Size (4) | Data (Size) |
+ *  ------------------------------------------
+ */
+class OverflowPage {
+ public:
+  void Init(page_id_t next_page_id, const char *data, uint32_t size) {
+    next_page_id_ = next_page_id;
+    size_ = size;
+    memcpy(data_, data, size);
+  }
+
+  page_id_t GetNextPageId() const { return next_page_id_; }
+
+  uint32_t GetSize() const { return size_; }
+
+  const char *GetData() const { return data_; }
+
+  static constexpr uint32_t MAX_DATA_SIZE = PAGE_USABLE_SIZE - sizeof(page_id_t) - sizeof(uint32_t);
+
+ private:
+  page_id_t next_page_id_;
+  uint32_t size_;
+  char data_[MAX_DATA_SIZE];
+};
+
+#endif  // MINISQL_OVERFLOW_PAGE_H
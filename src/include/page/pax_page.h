@@ -0,0 +1,157 @@
+#ifndef MINISQL_PAX_PAGE_H
+#define MINISQL_PAX_PAGE_H
+
+#include <cstring>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/rowid.h"
+#include "page/page.h"
+#include "record/row.h"
+#include "transaction/lock_manager.h"
+#include "transaction/log_manager.h"
+#include "transaction/transaction.h"
+
+/**
+ * Layout of the pages of a table heap, chosen when the table is created.
+ */
+enum class TableLayout : uint32_t {
+  kRow = 0,  // slotted pages of whole serialized rows, see TablePage
+  kPax,      // the values of a page grouped per column, see PaxPage
+};
+
+/**
+ * PAX page: the rows of the page are split into one minipage per column, so that a scan reads the columns it needs
+ * and skips the others. Every value of a column takes the same width, a CHAR(n) value takes its length (4) and n
+ * bytes, so a page holds a fixed number of slots computed from the schema. As in a TablePage, the rid of a row is
+ * its slot.
+ *
+ * The header starts like the one of a TablePage, so the page chain is walked the same way for both layouts.
+ *
+ * Format (size in byte):
+ *  ------------------------------------------------------------------------------------------------------------
+ * | PageId (4) | LSN (4) | PrevPageId (4) | NextPageId (4) | Capacity (4) | SlotCount (4) | UsedCount (4) |
+ *  ------------------------------------------------------------------------------------------------------------
+ * | ColumnCount (4) | MinipageOffset_1 (4) | ... | MinipageOffset_n (4) | SlotState_1 (1) | ... | SlotState_c (1) |
+ *  ------------------------------------------------------------------------------------------------------------
+ *  Minipage format:
+ *  ----------------------------------------------------
+ * | NullBitmap ((c + 7) / 8) | Value_1 | ... | Value_c |
+ *  ----------------------------------------------------
+ */
+class PaxPage : public Page {
+ public:
+  /**
+   * @return the number of rows a page of the schema holds, 0 if not even one row fits
+   */
+  static uint32_t ComputeCapacity(const Schema *schema);
+
+  /**
+   * @return whether every value of the row fits the width of its column
+   */
+  static bool RowFits(const Row &row, const Schema *schema);
+
+  void Init(page_id_t page_id, page_id_t prev_id, const Schema *schema, LogManager *log_mgr, Transaction *txn);
+
+  page_id_t GetTablePageId() { return *reinterpret_cast<page_id_t *>(GetData()); }
+
+  page_id_t GetPrevPageId() { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_PREV_PAGE_ID); }
+
+  page_id_t GetNextPageId() { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_NEXT_PAGE_ID); }
+
+  void SetPrevPageId(page_id_t prev_page_id) {
+    memcpy(GetData() + OFFSET_PREV_PAGE_ID, &prev_page_id, sizeof(page_id_t));
+  }
+
+  void SetNextPageId(page_id_t next_page_id) {
+    memcpy(GetData() + OFFSET_NEXT_PAGE_ID, &next_page_id, sizeof(page_id_t));
+  }
+
+  bool InsertTuple(Row &row, Schema *schema, Transaction *txn, LockManager *lock_manager, LogManager *log_manager);
+
+  bool MarkDelete(const RowId &rid, Transaction *txn, LockManager *lock_manager, LogManager *log_manager);
+
+  /**
+   * Overwrite a tuple in place, the row must fit its columns.
+   * @return 1 on success, -1 if the slot is invalid, -2 if the tuple is deleted
+   */
+  int UpdateTuple(const Row &new_row, Row *old_row, Schema *schema, Transaction *txn, LockManager *lock_manager,
+                  LogManager *log_manager);
+
+  void ApplyDelete(const RowId &rid, Transaction *txn, LogManager *log_manager);
+
+  void RollbackDelete(const RowId &rid, Transaction *txn, LogManager *log_manager);
+
+  bool GetTuple(Row *row, Schema *schema, Transaction *txn, LockManager *lock_manager);
+
+  /**
+   * Read some columns of a live tuple into `row`, whose fields are replaced. The columns not asked for are NULL.
+   */
+  void ReadColumns(uint32_t slot_num, const Schema *schema, const std::vector<uint32_t> &columns, Row *row);
+
+  bool GetFirstTupleRid(RowId *first_rid);
+
+  bool GetNextTupleRid(const RowId &cur_rid, RowId *next_rid);
+
+  /**
+   * @return whether the slot holds a tuple which is not deleted
+   */
+  bool IsLive(uint32_t slot_num) { return slot_num < GetSlotCount() && GetSlotState(slot_num) == SLOT_LIVE; }
+
+  uint32_t GetFreeSlotCount() { return GetCapacity() - GetUsedCount(); }
+
+ private:
+  uint32_t GetCapacity() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_CAPACITY); }
+
+  uint32_t GetSlotCount() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_SLOT_COUNT); }
+
+  void SetSlotCount(uint32_t slot_count) { memcpy(GetData() + OFFSET_SLOT_COUNT, &slot_count, sizeof(uint32_t)); }
+
+  uint32_t GetUsedCount() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_USED_COUNT); }
+
+  void SetUsedCount(uint32_t used_count) { memcpy(GetData() + OFFSET_USED_COUNT, &used_count, sizeof(uint32_t)); }
+
+  uint32_t GetColumnCount() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_COLUMN_COUNT); }
+
+  uint32_t GetMinipageOffset(uint32_t column) {
+    return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_MINIPAGE_OFFSETS + sizeof(uint32_t) * column);
+  }
+
+  uint8_t *GetSlotStates() {
+    return reinterpret_cast<uint8_t *>(GetData() + OFFSET_MINIPAGE_OFFSETS + sizeof(uint32_t) * GetColumnCount());
+  }
+
+  uint8_t GetSlotState(uint32_t slot_num) { return GetSlotStates()[slot_num]; }
+
+  void SetSlotState(uint32_t slot_num, uint8_t state) { GetSlotStates()[slot_num] = state; }
+
+  /** Write the values of a row into a slot */
+  void WriteRow(uint32_t slot_num, const Row &row, const Schema *schema);
+
+  /**
+   * @return a new field holding the value of a column in a slot
+   * @param arena the arena the field is carved from, nullptr for the heap
+   */
+  Field *ReadField(uint32_t slot_num, uint32_t column, const Schema *schema, MemoryArena *arena = nullptr);
+
+  /** @return the bytes a value of the column takes in its minipage */
+  static uint32_t GetValueWidth(const Column *column);
+
+  /** @return the size of the header of a page of `column_count` columns holding `capacity` slots */
+  static uint32_t GetHeaderSize(uint32_t column_count, uint32_t capacity) {
+    return OFFSET_MINIPAGE_OFFSETS + sizeof(uint32_t) * column_count + capacity;
+  }
+
+  static constexpr uint8_t SLOT_EMPTY = 0;
+  static constexpr uint8_t SLOT_LIVE = 1;
+  static constexpr uint8_t SLOT_DELETED = 2;
+  static constexpr size_t OFFSET_PREV_PAGE_ID = 8;
+  static constexpr size_t OFFSET_NEXT_PAGE_ID = 12;
+  static constexpr size_t OFFSET_CAPACITY = 16;
+  static constexpr size_t OFFSET_SLOT_COUNT = 20;
+  static constexpr size_t OFFSET_USED_COUNT = 24;
+  static constexpr size_t OFFSET_COLUMN_COUNT = 28;
+  static constexpr size_t OFFSET_MINIPAGE_OFFSETS = 32;
+};
+
+#endif  // MINISQL_PAX_PAGE_H
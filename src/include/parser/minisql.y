@@ -12,7 +12,7 @@
 }
 
 %token <syntax_node> CREATE DROP SELECT INSERT DELETE UPDATE
-%token <syntax_node> TRXBEGIN TRXCOMMIT TRXROLLBACK QUIT EXECFILE SHOW USE USING
+%token <syntax_node> TRXBEGIN TRXCOMMIT TRXROLLBACK QUIT EXECFILE SHOW USE USING STATUS COPY WITH
 %token <syntax_node> DATABASE DATABASES TABLE TABLES INDEX INDEXES
 %token <syntax_node> ON FROM WHERE INTO SET VALUES PRIMARY KEY UNIQUE
 %token <syntax_node> CHAR INT FLOAT AND OR NOT IS FLAGNULL
@@ -26,8 +26,8 @@
 %type <syntax_node> sql_trx_begin sql_trx_commit sql_trx_rollback
 %type <syntax_node> sql_select select_columns column_values column_value operator
 %type <syntax_node> connector where_conditions where_condition
-%type <syntax_node> sql_insert sql_delete sql_update update_values update_value
-%type <syntax_node> sql_quit sql_exec_file
+%type <syntax_node> sql_insert sql_delete sql_update update_values update_value value_tuples value_tuple
+%type <syntax_node> sql_quit sql_exec_file sql_show_status sql_copy
 
 %%
 
@@ -58,6 +58,8 @@ sql:
   | sql_trx_rollback { $$ = $1; }
   | sql_quit { $$ = $1; }
   | sql_exec_file { $$ = $1; }
+  | sql_show_status { $$ = $1; }
+  | sql_copy { $$ = $1; }
   ;
 
 sql_create_database:
@@ -101,6 +103,17 @@ sql_create_table:
     SyntaxNodeAddChildren($$, $3);
     SyntaxNodeAddChildren($$, list_node);
   }
+  | CREATE TABLE IDENTIFIER '(' column_definition_list ')' WITH '(' IDENTIFIER EQ IDENTIFIER ')' {
+    $$ = CreateSyntaxNode(kNodeCreateTable, NULL);
+    pSyntaxNode list_node = CreateSyntaxNode(kNodeColumnDefinitionList, NULL);
+    SyntaxNodeAddChildren(list_node, $5);
+    pSyntaxNode option_node = CreateSyntaxNode(kNodeTableOption, NULL);
+    SyntaxNodeAddChildren(option_node, $9);
+    SyntaxNodeAddChildren(option_node, $11);
+    SyntaxNodeAddChildren($$, $3);
+    SyntaxNodeAddChildren($$, list_node);
+    SyntaxNodeAddChildren($$, option_node);
+  }
   ;
 
 column_list:
@@ -195,6 +208,12 @@ sql_show_indexes:
   }
   ;
 
+sql_show_status:
+  SHOW STATUS {
+    $$ = CreateSyntaxNode(kNodeShowStatus, NULL);
+  }
+  ;
+
 sql_select:
   SELECT select_columns FROM IDENTIFIER {
     $$ = CreateSyntaxNode(kNodeSelect, NULL);
@@ -289,12 +308,36 @@ operator:
   ;
 
 sql_insert:
-  INSERT INTO IDENTIFIER VALUES '(' column_values ')' {
+  INSERT INTO IDENTIFIER VALUES value_tuples {
+    pSyntaxNode tuples = NULL, p = $5, next;
+    /* put the tuples back in order */
+    while (p != NULL) {
+      next = p->next_;
+      p->next_ = tuples;
+      tuples = p;
+      p = next;
+    }
     $$ = CreateSyntaxNode(kNodeInsert, NULL);
     SyntaxNodeAddChildren($$, $3);
-    pSyntaxNode col_val_node = CreateSyntaxNode(kNodeColumnValues, NULL);
-    SyntaxNodeAddChildren(col_val_node, $6);
-    SyntaxNodeAddChildren($$, col_val_node);
+    SyntaxNodeAddChildren($$, tuples);
+  }
+  ;
+
+/* left recursive to parse any number of tuples, collected in reverse to append each in O(1) */
+value_tuples:
+  value_tuples ',' value_tuple {
+    $$ = $3;
+    $$->next_ = $1;
+  }
+  | value_tuple {
+    $$ = $1;
+  }
+  ;
+
+value_tuple:
+  '(' column_values ')' {
+    $$ = CreateSyntaxNode(kNodeColumnValues, NULL);
+    SyntaxNodeAddChildren($$, $2);
   }
   ;
 
@@ -380,6 +423,14 @@ sql_trx_rollback:
   }
   ;
 
+sql_copy:
+  COPY IDENTIFIER FROM STRING {
+    $$ = CreateSyntaxNode(kNodeCopy, NULL);
+    SyntaxNodeAddChildren($$, $2);
+    SyntaxNodeAddChildren($$, $4);
+  }
+  ;
+
 sql_quit:
   QUIT {
     $$ = CreateSyntaxNode(kNodeQuit, NULL);
@@ -23,7 +23,9 @@ typedef enum {
   kNodeCreateTable,          /** create table command */
   kNodeDropTable,            /** drop table command */
   kNodeShowIndexes,          /** show indexes command */
+  kNodeShowStatus,           /** show status command */
   kNodeInsert,               /** insert command */
+  kNodeCopy,                 /** copy from file command */
   kNodeDelete,               /** delete command */
   kNodeUpdate,               /** update command */
   kNodeSelect,               /** select command */
@@ -41,6 +43,7 @@ typedef enum {
   kNodeCreateIndex,          /** create index command */
   kNodeDropIndex,            /** drop index command */
   kNodeIndexType,            /** type of index */
+  kNodeTableOption,          /** option of create table, contains the option identifier and its value */
   kNodeTrxBegin,             /** begin transaction command */
   kNodeTrxCommit,            /** commit transaction command */
   kNodeTrxRollback           /** rollback transaction command */
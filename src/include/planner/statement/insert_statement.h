@@ -12,44 +12,38 @@ class InsertStatement : public AbstractStatement {
  public:
   explicit InsertStatement(pSyntaxNode ast, ExecuteContext *context) : AbstractStatement(ast, context) {}
 
-  /** Transfer syntax tree to statement. */
+  /** Transfer syntax tree to statement, a loop over the siblings since an insert may carry any number of tuples. */
   void SyntaxTree2Statement(pSyntaxNode ast) {
-    if (!ast)
-      return;
-    switch (ast->type_) {
-      case kNodeIdentifier: {
-        TableInfo *info = nullptr;
-        if (context_->GetCatalog()->GetTable(ast->val_, info) != DB_SUCCESS) {
-          std::stringstream error_info;
-          error_info << "the table " << ast->val_ << " is not exist.";
-          throw std::logic_error(error_info.str());
+    for (; ast != nullptr; ast = ast->next_) {
+      switch (ast->type_) {
+        case kNodeIdentifier: {
+          TableInfo *info = nullptr;
+          if (context_->GetCatalog()->GetTable(ast->val_, info) != DB_SUCCESS) {
+            std::stringstream error_info;
+            error_info << "the table " << ast->val_ << " is not exist.";
+            throw std::logic_error(error_info.str());
+          }
+          table_name_ = ast->val_;
+          schema_ = info->GetSchema();
+          break;
         }
-        table_name_ = ast->val_;
-        break;
-      }
-      case kNodeColumnValues: {
-        MakeInsertValues(ast->child_);
-        break;
+        case kNodeColumnValues: {
+          MakeInsertValues(ast->child_);
+          break;
+        }
+        default:
+          throw std::logic_error("the ast_type is not supported in planner yet");
       }
-      default:
-        throw std::logic_error("the ast_type is not supported in planner yet");
     }
-    SyntaxTree2Statement(ast->next_);
   };
 
   void MakeInsertValues(pSyntaxNode ast) {
     std::vector<AbstractExpressionRef> value;
-    TableInfo *info = nullptr;
-    context_->GetCatalog()->GetTable(table_name_, info);
-    auto columns = info->GetSchema()->GetColumns();
-
-    for (auto column : columns) {
+    for (auto column : schema_->GetColumns()) {
       if (!ast)
         throw std::logic_error("The inserted value does not match the schema");
-      if (ast_->type_ == kNodeNull) {
-        auto f = new Field(column->GetType());
-        value.emplace_back(std::make_shared<ConstantValueExpression>(*f));
-        delete f;
+      if (ast->type_ == kNodeNull) {
+        value.emplace_back(std::make_shared<ConstantValueExpression>(Field(column->GetType())));
       } else {
         value.emplace_back(MakeConstantValueExpression(column->GetType(), ast));
       }
@@ -57,12 +51,15 @@ class InsertStatement : public AbstractStatement {
     }
     if (ast)
       throw std::logic_error("The inserted value does not match the schema");
-    raw_values_.emplace_back(value);
+    raw_values_.emplace_back(std::move(value));
   }
 
   /** Bound FROM clause. */
   std::string table_name_;
 
+  /** Schema of the bound table, looked up once for all the tuples. */
+  Schema *schema_ = nullptr;
+
   /** Bound Select statement, used in "insert into t1 select..." */
   SelectStatement *select_ = nullptr;
 
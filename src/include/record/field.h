@@ -6,6 +6,7 @@
 
 #include "common/config.h"
 #include "common/macros.h"
+#include "common/memory_arena.h"
 #include "record/type_id.h"
 #include "record/types.h"
 
@@ -22,7 +23,7 @@ class Field {
   explicit Field(const TypeId type) : type_id_(type), len_(FIELD_NULL_LEN), is_null_(true) {}
 
   ~Field() {
-    if (type_id_ == TypeId::kTypeChar && manage_data_) {
+    if (type_id_ == TypeId::kTypeChar && manage_data_ && !arena_data_) {
       delete[] value_.chars_;
     }
   }
@@ -61,12 +62,27 @@ class Field {
     }
   }
 
+  // char copied into an arena, the field itself may live in the arena
+  explicit Field(TypeId type, const char *data, uint32_t len, MemoryArena *arena)
+      : type_id_(type), len_(len), manage_data_(true), arena_data_(true) {
+    ASSERT(type == TypeId::kTypeChar, "Invalid type.");
+    value_.chars_ = arena->CopyChars(data, len);
+  }
+
+  // char stored in overflow pages, only its length and the first page of the chain are known
+  explicit Field(TypeId type, uint32_t len, page_id_t overflow_page_id)
+      : type_id_(type), len_(len), overflow_page_id_(overflow_page_id) {
+    ASSERT(type == TypeId::kTypeChar, "Invalid type.");
+    value_.chars_ = nullptr;
+  }
+
   // copy constructor
   explicit Field(const Field &other) {
     type_id_ = other.type_id_;
     len_ = other.len_;
     is_null_ = other.is_null_;
     manage_data_ = other.manage_data_;
+    overflow_page_id_ = other.overflow_page_id_;
     if (type_id_ == TypeId::kTypeChar && !is_null_ && manage_data_) {
       value_.chars_ = new char[len_];
       memcpy(value_.chars_, other.value_.chars_, len_);
@@ -75,8 +91,41 @@ class Field {
     }
   }
 
+  // copy into an arena, the chars of the copy are carved from it
+  explicit Field(const Field &other, MemoryArena *arena)
+      : type_id_(other.type_id_), len_(other.len_), is_null_(other.is_null_),
+        overflow_page_id_(other.overflow_page_id_) {
+    if (type_id_ == TypeId::kTypeChar && !is_null_ && other.value_.chars_ != nullptr) {
+      value_.chars_ = arena->CopyChars(other.value_.chars_, len_);
+      manage_data_ = true;
+      arena_data_ = true;
+    } else {
+      value_ = other.value_;
+    }
+  }
+
+  // move constructor, `other` is left NULL and owns nothing
+  Field(Field &&other) noexcept
+      : value_(other.value_), type_id_(other.type_id_), len_(other.len_), is_null_(other.is_null_),
+        manage_data_(other.manage_data_), overflow_page_id_(other.overflow_page_id_), arena_data_(other.arena_data_) {
+    other.value_.chars_ = nullptr;
+    other.is_null_ = true;
+    other.manage_data_ = false;
+    other.arena_data_ = false;
+    other.overflow_page_id_ = INVALID_PAGE_ID;
+  }
+
   // copy
-  Field &operator=(Field &other) {
+  Field &operator=(const Field &other) {
+    if (this != &other) {
+      Field copy(other);
+      Swap(*this, copy);
+    }
+    return *this;
+  }
+
+  // move, `other` takes the old value and gives it back when destroyed
+  Field &operator=(Field &&other) noexcept {
     Swap(*this, other);
     return *this;
   }
@@ -87,8 +136,28 @@ class Field {
 
   inline TypeId GetTypeId() const { return type_id_; }
 
+  /**
+   * @return whether the value lies in overflow pages and is not loaded, such a field is read from a table page and
+   * stands in for the value until the table heap fetches it
+   */
+  inline bool IsOverflow() const { return overflow_page_id_ != INVALID_PAGE_ID; }
+
+  inline page_id_t GetOverflowPageId() const { return overflow_page_id_; }
+
   inline const char *GetData() const { return Type::GetInstance(type_id_)->GetData(*this); }
 
+  /**
+   * Raw accessors for code specialized on the type of the field, they skip the dispatch through Type and must only be
+   * called on a non NULL field of the matching type
+   */
+  inline int32_t GetInt() const { return value_.integer_; }
+
+  inline float GetFloat() const { return value_.float_; }
+
+  inline const char *GetChars() const { return value_.chars_; }
+
+  inline uint32_t GetCharLength() const { return len_; }
+
   inline uint32_t SerializeTo(char *buf) const { return Type::GetInstance(type_id_)->SerializeTo(*this, buf); }
 
   inline static uint32_t DeserializeFrom(char *buf, const TypeId type_id, Field **field, bool is_null) {
@@ -127,6 +196,8 @@ class Field {
     std::swap(first.len_, second.len_);
     std::swap(first.is_null_, second.is_null_);
     std::swap(first.manage_data_, second.manage_data_);
+    std::swap(first.overflow_page_id_, second.overflow_page_id_);
+    std::swap(first.arena_data_, second.arena_data_);
   }
 
   std::string toString() {
@@ -154,6 +225,8 @@ class Field {
   uint32_t len_;
   bool is_null_{false};
   bool manage_data_{false};
+  page_id_t overflow_page_id_{INVALID_PAGE_ID};
+  bool arena_data_{false};  // the chars lie in a memory arena and are not deleted, a copy still gets its own
 };
 
 #endif  // MINISQL_FIELD_H
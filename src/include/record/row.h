@@ -2,6 +2,7 @@
 #define MINISQL_ROW_H
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "common/macros.h"
@@ -11,15 +12,14 @@
 
 /**
  *  Row format:
- * -------------------------------------------
- * | Header | Field-1 | ... | Field-N |
- * -------------------------------------------
- *  Header format:
- * --------------------------------------------
- * | Field Nums | Null bitmap |
- * -------------------------------------------
- *
- *
+ * -----------------------------------------------------------------------------------------------
+ * | Version (1) | Null bitmap ((N + 7) / 8) | Fixed section | VarEnd-1 (2) ... VarEnd-V (2) | Var data |
+ * -----------------------------------------------------------------------------------------------
+ *  The rid of a row is its slot and the column count comes from the schema, neither is stored. The fixed section holds
+ *  the INT and FLOAT columns at the offsets the schema computes, NULL or not. The V CHAR columns follow in the var
+ *  data, each entry of the offset array is the end of a value relative to the var data, so a value starts where the
+ *  previous one ends. A value in overflow pages is flagged in the high bit of its entry and its bytes in the var data
+ *  are its length (4) and the first page of its chain (4). Every column is read in O(1).
  */
 class Row {
  public:
@@ -36,8 +36,11 @@ class Row {
 
   void destroy() {
     if (!fields_.empty()) {
-      for (auto field : fields_) {
-        delete field;
+      // the fields of a row in an arena are given back with the arena
+      if (arena_ == nullptr) {
+        for (auto field : fields_) {
+          delete field;
+        }
       }
       fields_.clear();
     }
@@ -56,25 +59,55 @@ class Row {
   Row(RowId rid) : rid_(rid) {}
 
   /**
-   * Row copy function, deep copy
+   * Row whose fields are carved from an arena, it must not outlive the arena
    */
-  Row(const Row &other) {
-    destroy();
-    rid_ = other.rid_;
+  explicit Row(MemoryArena *arena) : arena_(arena) {}
+
+  /**
+   * Row copy function, deep copy. The copy of a row in an arena is made in the same arena.
+   */
+  Row(const Row &other) : rid_(other.rid_), arena_(other.arena_) {
     for (auto &field : other.fields_) {
-      fields_.push_back(new Field(*field));
+      fields_.push_back(CopyField(*field));
     }
   }
 
   /**
-   * Assign operator, deep copy
+   * Row move function, the fields are handed over without being copied
+   */
+  Row(Row &&other) noexcept : rid_(other.rid_), fields_(std::move(other.fields_)), arena_(other.arena_) {
+    other.fields_.clear();
+  }
+
+  /**
+   * Assign operator, deep copy into the arena of this row if it has one
    */
   Row &operator=(const Row &other) {
+    if (this == &other) {
+      return *this;
+    }
     destroy();
     rid_ = other.rid_;
     for (auto &field : other.fields_) {
-      fields_.push_back(new Field(*field));
+      fields_.push_back(CopyField(*field));
+    }
+    return *this;
+  }
+
+  /**
+   * Move assign operator, the fields are handed over if both rows take them from the same place, the heap or the same
+   * arena, and deep copied otherwise
+   */
+  Row &operator=(Row &&other) {
+    if (this == &other) {
+      return *this;
+    }
+    if (arena_ != other.arena_) {
+      return *this = other;
     }
+    destroy();
+    rid_ = other.rid_;
+    fields_.swap(other.fields_);
     return *this;
   }
 
@@ -85,6 +118,19 @@ class Row {
 
   uint32_t DeserializeFrom(char *buf, Schema *schema);
 
+  /**
+   * Deserialize only some columns, the others are NULL.
+   * @return the size of the serialized row
+   */
+  uint32_t DeserializeFrom(char *buf, Schema *schema, const std::vector<uint32_t> &columns);
+
+  /**
+   * @return a new field holding one column of a serialized row, without reading the columns before it
+   * @param arena the arena the field is carved from, nullptr for the heap
+   */
+  static Field *DeserializeField(const char *buf, const Schema *schema, uint32_t column_index,
+                                 MemoryArena *arena = nullptr);
+
   /**
    * For empty row, return 0
    * For non-empty row with null fields, eg: |null|null|null|, return header size only
@@ -107,9 +153,30 @@ class Row {
 
   inline size_t GetFieldCount() const { return fields_.size(); }
 
+  /**
+   * Make the row hold `count` fields, to be overwritten by SetField. The fields are kept if the row has as many
+   * already, so that a row filled again and again allocates them once; new ones are NULL until set.
+   */
+  void ResizeFields(uint32_t count);
+
+  /**
+   * Overwrite a field in place by a copy of `field`, the copy owns its chars
+   */
+  void SetField(uint32_t idx, const Field &field);
+
+  /** @return the arena the fields are carved from, nullptr for the heap */
+  inline MemoryArena *GetArena() const { return arena_; }
+
  private:
+  /** @return a copy of `field` owned by this row */
+  Field *CopyField(const Field &field) const;
+
+  /** @return the value of `field`, its chars copied into the arena of this row or onto the heap */
+  Field CopyValue(const Field &field) const;
+
   RowId rid_{};
   std::vector<Field *> fields_; /** Make sure that all field ptr are destructed*/
+  MemoryArena *arena_{nullptr};
 };
 
 #endif  // MINISQL_ROW_H
@@ -13,7 +13,9 @@
 class Schema {
  public:
   explicit Schema(const std::vector<Column *> columns, bool is_manage_ = true)
-      : columns_(std::move(columns)), is_manage_(is_manage_) {}
+      : columns_(std::move(columns)), is_manage_(is_manage_) {
+    ComputeRowLayout();
+  }
 
   ~Schema() {
     if (is_manage_) {
@@ -39,6 +41,21 @@ class Schema {
 
   inline uint32_t GetColumnCount() const { return static_cast<uint32_t>(columns_.size()); }
 
+  /**
+   * Layout of a serialized row, see Row: a fixed-width column sits at the same offset of the fixed section in every
+   * row, a CHAR column is found through its entry in the offset array of the variable-length section.
+   */
+  inline bool IsFixedWidth(const uint32_t column_index) const {
+    return columns_[column_index]->GetType() != TypeId::kTypeChar;
+  }
+
+  /** @return the offset of a fixed-width column in the fixed section, or the index of a CHAR column among them */
+  inline uint32_t GetRowOffset(const uint32_t column_index) const { return row_offsets_[column_index]; }
+
+  inline uint32_t GetFixedSize() const { return fixed_size_; }
+
+  inline uint32_t GetVarColumnCount() const { return var_column_count_; }
+
   /**
    * Shallow copy schema, only used in index
    *
@@ -81,9 +98,23 @@ class Schema {
   static uint32_t DeserializeFrom(char *buf, Schema *&schema);
 
  private:
+  void ComputeRowLayout() {
+    for (uint32_t i = 0; i < columns_.size(); i++) {
+      if (IsFixedWidth(i)) {
+        row_offsets_.push_back(fixed_size_);
+        fixed_size_ += Type::GetTypeSize(columns_[i]->GetType());
+      } else {
+        row_offsets_.push_back(var_column_count_++);
+      }
+    }
+  }
+
   static constexpr uint32_t SCHEMA_MAGIC_NUM = 200715;
   std::vector<Column *> columns_;
   bool is_manage_ = false; /** if false, don't need to delete pointer to column */
+  std::vector<uint32_t> row_offsets_;
+  uint32_t fixed_size_{0};
+  uint32_t var_column_count_{0};
 };
 
 using IndexSchema = Schema;
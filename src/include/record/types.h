@@ -120,6 +120,9 @@ class TypeChar : public Type {
   virtual CmpBool CompareGreaterThan(const Field &left, const Field &right) const override;
 
   virtual CmpBool CompareGreaterThanEquals(const Field &left, const Field &right) const override;
+
+  /** Set in the length of a serialized value stored in overflow pages, the id of the first page follows */
+  static constexpr uint32_t OVERFLOW_FLAG = 1U << 31;
 };
 
 class TypeFloat : public Type {
@@ -2,28 +2,53 @@
 #define DISK_MGR_H
 
 #include <atomic>
-#include <fstream>
 #include <iostream>
-#include <thread>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "common/config.h"
 #include "common/macros.h"
+#include "common/statistics.h"
 #include "page/bitmap_page.h"
 #include "page/disk_file_meta_page.h"
 
+/**
+ * How the DiskManager hands the pages of the database file to the buffer pool.
+ */
+enum class DiskAccessMode {
+  kFileIO = 0,    // pages are copied into buffer pool frames with pread/pwrite
+  kMemoryMapped,  // buffer pool frames point straight into a private mapping of the file
+};
+
 /**
  * DiskManager takes care of the allocation and de allocation of pages within a database. It performs the reading and
  * writing of pages to and from disk, providing a logical file layer within the context of a database management system.
  *
+ * Pages are read and written with positional pread/pwrite on one file descriptor, so concurrent requests do not share
+ * a file cursor or a latch. Writes only reach the OS page cache, durability comes from an explicit Sync(). Every page
+ * written is stamped with a checksum in its last PAGE_CHECKSUM_SIZE bytes, which is verified when it is read back, see
+ * storage/page_checksum.h.
+ *
+ * The free page bitmaps are cached in memory once an extent is first touched and written back lazily together with
+ * the meta page, so allocating, freeing and checking pages costs no I/O. The per extent used page counters of the meta
+ * page tell which extents still have free pages.
+ *
+ * In memory mapped mode the file is also mapped MAP_PRIVATE, and the buffer pool reads pages in place through
+ * GetMappedPage() instead of copying them into its own frames. The first store to a mapped page makes the kernel copy
+ * it, so only dirtied pages cost extra memory, and the file itself still only changes through WritePage().
+ *
  * Disk page storage format: (Free Page BitMap Size = PAGE_SIZE * 8, we note it as N)
  * | Meta Page | Free Page BitMap 1 | Page 1 | Page 2 | ....
  *      | Page N | Free Page BitMap 2 | Page N+1 | ... | Page 2N | ... |
  */
 class DiskManager {
  public:
-  explicit DiskManager(const std::string &db_file);
+  /**
+   * Open or create a database file. If the file cannot be mapped, memory mapped mode falls back to file I/O.
+   */
+  explicit DiskManager(const std::string &db_file, DiskAccessMode access_mode = DiskAccessMode::kFileIO);
 
   ~DiskManager() {
     if (!closed) {
@@ -34,8 +59,9 @@ class DiskManager {
   /**
    * Read page from specific page_id
    * Note: page_id = 0 is reserved for free page bit map
+   * @return false if the page failed its checksum, the data read is left in `page_data`
    */
-  void ReadPage(page_id_t logical_page_id, char *page_data);
+  bool ReadPage(page_id_t logical_page_id, char *page_data);
 
   /**
    * Write data to specific page
@@ -43,12 +69,44 @@ class DiskManager {
    */
   void WritePage(page_id_t logical_page_id, const char *page_data);
 
+  /**
+   * @return whether the buffer pool should read pages in place through GetMappedPage()
+   */
+  bool IsMemoryMapped() const { return mapping_ != nullptr; }
+
+  /**
+   * @return the address of a page inside the mapping, the file is grown first if the page lies beyond its end.
+   * Stores to the page are private until the page is written back with WritePage().
+   */
+  char *GetMappedPage(page_id_t logical_page_id);
+
+  /**
+   * Verify the checksum of a mapped page, as ReadPage() does for a page read from the file.
+   */
+  bool VerifyMappedPage(page_id_t logical_page_id);
+
+  /**
+   * Drop the private copy of a mapped page, if any, so that the next access sees the page as written to the file.
+   */
+  void ReleaseMappedPage(page_id_t logical_page_id);
+
+  /**
+   * Ask the kernel to start reading a mapped page ahead of its first access.
+   */
+  void PrefetchMappedPage(page_id_t logical_page_id);
+
   /**
    * Get next free page from disk
    * @return logical page id of allocated page
    */
   page_id_t AllocatePage();
 
+  /**
+   * Allocate `count` contiguous pages inside one extent
+   * @return logical page id of the first allocated page, INVALID_PAGE_ID if no extent has such a free run
+   */
+  page_id_t AllocatePages(uint32_t count);
+
   /**
    * Free this page and reset bit map
    */
@@ -59,31 +117,51 @@ class DiskManager {
    */
   bool IsPageFree(page_id_t logical_page_id);
 
+  /**
+   * Write the meta page holding the allocation counters and the dirty free page bitmaps back to disk.
+   */
+  void FlushMetaPage();
+
+  /**
+   * Force the pages written so far to stable storage, a no-op if nothing was written since the last sync.
+   * Called at checkpoints and on close so that the fsyncs are batched instead of paid per page.
+   */
+  void Sync();
+
   /**
    * Shut down the disk manager and close all the file resources.
    */
   void Close();
 
+  /**
+   * @return a snapshot of the I/O counters
+   */
+  DiskStats GetStats() const;
+
   /**
    * Get Meta Page
    * Note: Used only for debug
    */
   char *GetMetaData() { return meta_data_; }
 
-  static constexpr size_t BITMAP_SIZE = BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
+  static constexpr size_t BITMAP_SIZE = BitmapPage<PAGE_USABLE_SIZE>::GetMaxSupportedSize();
 
   static constexpr size_t EXTENT_SIZE = MAX_VALID_PAGE_ID / BITMAP_SIZE;
 
+  /** Number of pages the file grows by when a mapped page lies beyond its end. */
+  static constexpr size_t MAPPED_GROW_PAGES = 256;
+
  private:
   /**
-   * Helper function to get disk file size
+   * Read physical page from disk
+   * @return false if the page failed its checksum
    */
-  int GetFileSize(const std::string &file_name);
+  bool ReadPhysicalPage(page_id_t physical_page_id, char *page_data);
 
   /**
-   * Read physical page from disk
+   * Count and report a page failing its checksum.
    */
-  void ReadPhysicalPage(page_id_t physical_page_id, char *page_data);
+  void ReportChecksumFailure(page_id_t physical_page_id);
 
   /**
    * Write data to physical page in disk
@@ -95,15 +173,48 @@ class DiskManager {
    */
   page_id_t MapPageId(page_id_t logical_page_id);
 
+  /**
+   * @return the cached free page bitmap of an extent, read from disk on first use. Caller holds meta_latch_.
+   */
+  BitmapPage<PAGE_USABLE_SIZE> *GetBitmap(uint32_t extent_id);
+
+  /**
+   * Write the dirty cached bitmaps back to disk. Caller holds meta_latch_.
+   */
+  void FlushBitmaps();
+
  private:
-  // stream to write db file
-  std::fstream db_io_;
+  // descriptor of the db file
+  int db_fd_{-1};
   std::string file_name_;
-  // with multiple buffer pool instances, need to protect file access
-  std::recursive_mutex db_io_latch_;
+  // size of the db file, kept in memory so that reads need no stat()
+  std::atomic<size_t> file_size_{0};
+  // whether pages were written since the last Sync()
+  std::atomic<bool> needs_sync_{false};
+  // private mapping of the whole addressable file in memory mapped mode, nullptr otherwise
+  char *mapping_{nullptr};
+  size_t mapping_size_{0};
+  // serializes growing the file for the mapping
+  std::mutex map_latch_;
+  // protects the meta page and the free page bitmaps against concurrent allocation
+  std::mutex meta_latch_;
   bool closed{false};
   char meta_data_[PAGE_SIZE];
-  uint16_t next_free_extent_;
+  /** A free page bitmap cached in memory. */
+  struct BitmapFrame {
+    char data_[PAGE_SIZE];
+    bool is_dirty_{false};
+  };
+  // cached bitmaps indexed by extent id, nullptr if the extent was not touched yet
+  std::vector<std::unique_ptr<BitmapFrame>> bitmaps_;
+  uint16_t next_free_extent_{0};
+  // counters, see DiskStats
+  std::atomic<uint64_t> num_reads_{0};
+  std::atomic<uint64_t> num_writes_{0};
+  std::atomic<uint64_t> num_flushes_{0};
+  std::atomic<uint64_t> num_allocations_{0};
+  std::atomic<uint64_t> num_deallocations_{0};
+  std::atomic<uint64_t> num_checksum_failures_{0};
 };
 
 #endif
\ No newline at end of file
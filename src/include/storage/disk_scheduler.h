@@ -0,0 +1,82 @@
+#ifndef MINISQL_DISK_SCHEDULER_H
+#define MINISQL_DISK_SCHEDULER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/config.h"
+#include "storage/disk_manager.h"
+
+/**
+ * A read or write of one logical page. The caller must keep `data_` alive until the request has completed.
+ */
+struct DiskRequest {
+  /** true for a write, false for a read */
+  bool is_write_{false};
+  /** logical page id of the page to read or write */
+  page_id_t page_id_{INVALID_PAGE_ID};
+  /** source buffer of a write, or destination buffer of a read */
+  char *data_{nullptr};
+  /** fulfilled once the request has completed, with false if the page read failed its checksum */
+  std::promise<bool> promise_;
+  /** optional completion callback, invoked on the worker thread before the promise is fulfilled */
+  std::function<void(bool)> callback_;
+};
+
+/**
+ * DiskScheduler is the long-lived I/O subsystem of the storage layer. A fixed pool of worker threads drains a shared
+ * request queue and performs the reads and writes through the DiskManager, so a page miss no longer pays for creating
+ * a thread, and several requests (e.g. a victim write-back and the read of the new page) can be in flight at once.
+ */
+class DiskScheduler {
+ public:
+  explicit DiskScheduler(DiskManager *disk_manager, size_t num_workers = DEFAULT_DISK_IO_WORKERS);
+
+  /**
+   * Drains the pending requests and stops all the workers.
+   */
+  ~DiskScheduler();
+
+  DISALLOW_COPY_AND_MOVE(DiskScheduler);
+
+  /**
+   * Queue a request, its promise is fulfilled by one of the workers once done.
+   */
+  void Schedule(DiskRequest request);
+
+  /**
+   * Queue the read of a page into `data`.
+   * @return a future which becomes ready once `data` holds the page, false if the page failed its checksum
+   */
+  std::future<bool> ScheduleRead(page_id_t page_id, char *data, std::function<void(bool)> callback = nullptr);
+
+  /**
+   * Queue the write of `data` to a page.
+   * @return a future which becomes ready once the data has been handed to the disk manager
+   */
+  std::future<bool> ScheduleWrite(page_id_t page_id, char *data, std::function<void(bool)> callback = nullptr);
+
+  DiskManager *GetDiskManager() { return disk_manager_; }
+
+  size_t GetNumWorkers() const { return workers_.size(); }
+
+ private:
+  /**
+   * Worker loop: pops requests until the scheduler shuts down and the queue is empty.
+   */
+  void WorkerLoop();
+
+  DiskManager *disk_manager_;
+  std::vector<std::thread> workers_;
+  std::deque<DiskRequest> queue_;
+  std::mutex queue_latch_;
+  std::condition_variable queue_cv_;
+  bool shutdown_{false};
+};
+
+#endif  // MINISQL_DISK_SCHEDULER_H
@@ -0,0 +1,46 @@
+#ifndef MINISQL_PAGE_CHECKSUM_H
+#define MINISQL_PAGE_CHECKSUM_H
+
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * Every page on disk ends with a CRC32C over the rest of the page and its physical page id, so that torn, corrupted
+ * and misplaced pages are caught. The DiskManager stamps the checksum on each write and verifies it on each read, the
+ * page contents only ever use the first PAGE_USABLE_SIZE bytes. A page of all zeros, e.g. a hole in the file, is
+ * valid as well.
+ */
+
+/**
+ * @return the checksum a page stored at `physical_page_id` must carry
+ */
+uint32_t ComputePageChecksum(const char *page_data, page_id_t physical_page_id);
+
+/**
+ * Store the checksum in the trailer of the page.
+ */
+void StampPageChecksum(char *page_data, page_id_t physical_page_id);
+
+/**
+ * @return whether the trailer of the page matches its contents
+ */
+bool VerifyPageChecksum(const char *page_data, page_id_t physical_page_id);
+
+/**
+ * Result of checking every page of a database file.
+ */
+struct ChecksumReport {
+  bool opened_{false};                    // whether the file could be read at all
+  size_t pages_checked_{0};               // number of physical pages in the file
+  std::vector<page_id_t> corrupt_pages_;  // physical ids of the pages failing their checksum, ascending
+};
+
+/**
+ * Verify every page of a database file, the file is split into one contiguous range of pages per thread. The file
+ * should not be open for writing meanwhile.
+ */
+ChecksumReport VerifyFileChecksums(const std::string &db_file, size_t num_threads);
+
+#endif  // MINISQL_PAGE_CHECKSUM_H
@@ -0,0 +1,51 @@
+#ifndef MINISQL_PAGE_RESERVATION_H
+#define MINISQL_PAGE_RESERVATION_H
+
+#include <cstdint>
+
+#include "common/config.h"
+
+/**
+ * PageReservation is a run of contiguous pages reserved on disk for one table heap or index. New pages of the object
+ * are taken from the run in page id order, so its page chain is laid out sequentially in the file and chain scans
+ * turn into large sequential reads that ReadAhead() can follow. When the run is used up, the buffer pool reserves the
+ * next one. A reservation belongs to one object and must not be shared between threads.
+ */
+class PageReservation {
+ public:
+  explicit PageReservation(uint32_t run_size = DEFAULT_PAGE_RUN_SIZE) : run_size_(run_size) {}
+
+  /** @return the number of pages reserved at once */
+  uint32_t GetRunSize() const { return run_size_; }
+
+  /** @return the number of reserved pages not handed out yet */
+  uint32_t GetRemaining() const { return static_cast<uint32_t>(end_ - next_); }
+
+  /** Take over the run of `count` pages starting at `first_page_id`. */
+  void Reset(page_id_t first_page_id, uint32_t count) {
+    next_ = first_page_id;
+    end_ = first_page_id + static_cast<page_id_t>(count);
+  }
+
+  /** @return the next reserved page, the reservation must not be empty */
+  page_id_t Take() { return next_++; }
+
+  /**
+   * Give back the page just taken, e.g. when no frame was available for it.
+   * @return false if the page was not the last one taken and could not be given back
+   */
+  bool PutBack(page_id_t page_id) {
+    if (page_id + 1 != next_) {
+      return false;
+    }
+    next_--;
+    return true;
+  }
+
+ private:
+  uint32_t run_size_;
+  page_id_t next_{0};
+  page_id_t end_{0};
+};
+
+#endif  // MINISQL_PAGE_RESERVATION_H
@@ -1,8 +1,19 @@
 #ifndef MINISQL_TABLE_HEAP_H
 #define MINISQL_TABLE_HEAP_H
 
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_access_strategy.h"
 #include "buffer/buffer_pool_manager.h"
+#include "common/dberr.h"
+#include "common/statistics.h"
+#include "page/free_space_map_page.h"
 #include "page/header_page.h"
+#include "page/overflow_page.h"
+#include "page/pax_page.h"
 #include "page/table_page.h"
 #include "storage/table_iterator.h"
 #include "transaction/lock_manager.h"
@@ -12,26 +23,44 @@ class TableHeap {
   friend class TableIterator;
 
  public:
+  /**
+   * @param layout layout of the pages, a pax table needs PaxPage::ComputeCapacity(schema) > 0
+   */
   static TableHeap *Create(BufferPoolManager *buffer_pool_manager, Schema *schema, Transaction *txn,
-                           LogManager *log_manager, LockManager *lock_manager) {
-    return new TableHeap(buffer_pool_manager, schema, txn, log_manager, lock_manager);
+                           LogManager *log_manager, LockManager *lock_manager,
+                           TableLayout layout = TableLayout::kRow) {
+    return new TableHeap(buffer_pool_manager, schema, txn, log_manager, lock_manager, layout);
   }
 
-  static TableHeap *Create(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
-                           LogManager *log_manager, LockManager *lock_manager) {
-    return new TableHeap(buffer_pool_manager, first_page_id, schema, log_manager, lock_manager);
+  static TableHeap *Create(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, page_id_t fsm_page_id,
+                           Schema *schema, LogManager *log_manager, LockManager *lock_manager,
+                           TableLayout layout = TableLayout::kRow) {
+    return new TableHeap(buffer_pool_manager, first_page_id, fsm_page_id, schema, log_manager, lock_manager, layout);
   }
 
-  ~TableHeap() {}
+  ~TableHeap() { buffer_pool_manager_->ReleaseReservation(&reservation_); }
 
   /**
-   * Insert a tuple into the table. If the tuple is too large (>= page_size), return false.
+   * Insert a tuple into the table, into a page the free space map knows to have room, or else into a new page
+   * appended to the chain. A CHAR value longer than CHAR_OVERFLOW_THRESHOLD is stored in overflow pages, the row only
+   * keeps its length and first page. If the tuple is still too large (>= page_size, or wider than its columns in a pax
+   * table), return false.
    * @param[in/out] row Tuple Row to insert, the rid of the inserted tuple is wrapped in object row
    * @param[in] txn The transaction performing the insert
    * @return true iff the insert is successful
    */
   bool InsertTuple(Row &row, Transaction *txn);
 
+  /**
+   * Insert a batch of tuples, each page is pinned once and filled with as many of the rows as fit before moving on.
+   * The batch is all or nothing: if it fails, the tuples already stored are deleted again.
+   * @param[in/out] rows Tuples to insert, their rids are wrapped in the rows
+   * @param[in] txn The transaction performing the insert
+   * @return DB_SUCCESS if all the tuples were inserted, DB_FAILED if a tuple is too large, DB_BUFFER_POOL_FULL if a
+   * page could not be fetched or allocated
+   */
+  dberr_t InsertTuples(std::vector<Row> &rows, Transaction *txn);
+
   /**
    * Mark the tuple as deleted. The actual delete will occur when ApplyDelete is called.
    * @param[in] rid Resource id of the tuple of delete
@@ -50,7 +79,8 @@ class TableHeap {
   bool UpdateTuple(Row &row, const RowId &rid, Transaction *txn);
 
   /**
-   * Called on Commit/Abort to actually delete a tuple or rollback an insert.
+   * Called on Commit/Abort to actually delete a tuple or rollback an insert. The freed space is recorded in the free
+   * space map and reused by later inserts.
    * @param rid Rid of the tuple to delete
    * @param txn Transaction performing the delete.
    */
@@ -71,6 +101,12 @@ class TableHeap {
    */
   bool GetTuple(Row *row, Transaction *txn);
 
+  /**
+   * Fetch the CHAR values of a row read from a page which lie in overflow pages, the fields standing in for them are
+   * replaced.
+   */
+  void ReadOverflow(Row *row);
+
   void FreeTableHeap() {
     auto next_page_id = first_page_id_;
     while (next_page_id != INVALID_PAGE_ID) {
@@ -84,14 +120,17 @@ class TableHeap {
   }
 
   /**
-   * Free table heap and release storage in disk file
+   * Free table heap and release storage in disk file, the pages are walked through a ring of frames. The free space
+   * map goes along with the whole table, or forgets the freed pages.
+   * @param page_id the page to start from, the whole table if INVALID_PAGE_ID
    */
   void DeleteTable(page_id_t page_id = INVALID_PAGE_ID);
 
   /**
+   * @param strategy ring the iterator reads its pages through, nullptr to use the shared buffer pool
    * @return the begin iterator of this table
    */
-  TableIterator Begin(Transaction *txn);
+  TableIterator Begin(Transaction *txn, BufferAccessStrategy *strategy = nullptr);
 
   /**
    * @return the end iterator of this table
@@ -103,38 +142,176 @@ class TableHeap {
    */
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
-private:
   /**
-   * create table heap and initialize first page
+   * @return the id of the first page of the free space map of this table
+   */
+  inline page_id_t GetFreeSpaceMapPageId() const { return fsm_page_id_; }
+
+  /**
+   * @return the layout of the pages of this table
+   */
+  inline TableLayout GetLayout() const { return layout_; }
+
+  /**
+   * @return the buffer pool counters charged to this table
+   */
+  AccessStats *GetAccessStats() { return &access_stats_; }
+
+ private:
+  /**
+   * create table heap and initialize first page and free space map
    */
   explicit TableHeap(BufferPoolManager *buffer_pool_manager, Schema *schema, Transaction *txn,
-                     LogManager *log_manager, LockManager *lock_manager) :
+                     LogManager *log_manager, LockManager *lock_manager, TableLayout layout) :
           buffer_pool_manager_(buffer_pool_manager),
           schema_(schema),
+          layout_(layout),
+          has_long_columns_(HasLongColumns(schema, layout)),
           log_manager_(log_manager),
           lock_manager_(lock_manager) {
-    auto first_page = reinterpret_cast<TablePage *>(buffer_pool_manager->NewPage(first_page_id_));
-    first_page->Init(first_page_id_, PAGE_SIZE, log_manager, txn);
+    auto first_page = buffer_pool_manager->NewPage(first_page_id_, &reservation_);
+    InitPage(first_page, first_page_id_, PAGE_SIZE, txn);
+    uint32_t free_bytes = GetFreeSpace(first_page);
     buffer_pool_manager->UnpinPage(first_page_id_, true);
     schema_ = schema;
+    // the map pages stay out of the reservation, which is kept for consecutive table pages
+    auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager->NewPage(fsm_page_id_)->GetData());
+    fsm_page->Init();
+    buffer_pool_manager->UnpinPage(fsm_page_id_, true);
+    fsm_loaded_ = true;
+    fsm_last_page_id_ = fsm_page_id_;
+    last_page_id_ = first_page_id_;
+    RecordFreeSpace(first_page_id_, free_bytes);
   };
 
-  explicit TableHeap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
-                     LogManager *log_manager, LockManager *lock_manager)
+  explicit TableHeap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, page_id_t fsm_page_id,
+                     Schema *schema, LogManager *log_manager, LockManager *lock_manager, TableLayout layout)
       : buffer_pool_manager_(buffer_pool_manager),
         first_page_id_(first_page_id),
+        fsm_page_id_(fsm_page_id),
         schema_(schema),
+        layout_(layout),
+        has_long_columns_(HasLongColumns(schema, layout)),
         log_manager_(log_manager),
         lock_manager_(lock_manager) {}
 
+  /**
+   * Link a new page at the tail of the chain.
+   * @param[out] page_id id of the new page
+   * @return the new page, pinned, nullptr if no page can be allocated
+   */
+  Page *AppendPage(page_id_t &page_id, Transaction *txn);
+
+  /**
+   * Call `func` with the page cast to the page class of the layout, TablePage or PaxPage, whose tuple methods match.
+   * The chain links sit at the same offsets in both, so the walks of the chain read any page as a TablePage.
+   */
+  template <typename Func>
+  auto VisitPage(Page *page, Func &&func) {
+    if (layout_ == TableLayout::kPax) {
+      return func(reinterpret_cast<PaxPage *>(page));
+    }
+    return func(reinterpret_cast<TablePage *>(page));
+  }
+
+  void InitPage(Page *page, page_id_t page_id, page_id_t prev_id, Transaction *txn);
+
+  /**
+   * @return whether the row can be stored in a page of this table
+   */
+  bool RowFits(const Row &row);
+
+  /**
+   * @return the free space of a page as the map records it, the map of a pax table counts free slots in units of
+   * CATEGORY_SIZE
+   */
+  uint32_t GetFreeSpace(Page *page);
+
+  /**
+   * @return the free space a page needs to take the row
+   */
+  uint32_t GetSpaceNeeded(const Row &row);
+
+  /**
+   * @return whether a row of the schema may hold a value long enough for overflow pages, only rows of a row layout
+   * table are spilled
+   */
+  static bool HasLongColumns(const Schema *schema, TableLayout layout);
+
+  /**
+   * Write the long CHAR values of a row to overflow pages.
+   * @param spilled receives a copy of the row with the long values replaced by their overflow pages
+   * @return the row to store, `&row` if no value was moved, nullptr if no overflow page could be allocated
+   */
+  Row *SpillLongValues(Row &row, Row &spilled);
+
+  /**
+   * Write a value to a new chain of overflow pages.
+   * @return the first page of the chain, INVALID_PAGE_ID if no page can be allocated
+   */
+  page_id_t WriteOverflow(const char *data, uint32_t len);
+
+  /**
+   * Free the overflow pages the values of a row stored in a page refer to.
+   */
+  void FreeOverflow(const Row &row);
+
+  void FreeOverflowChain(page_id_t page_id);
+
+  /**
+   * Free the overflow pages of the tuples of a table page, before the page goes away.
+   */
+  void FreePageOverflow(TablePage *page);
+
+  /**
+   * Read the free space map into memory on first use, so that opening a table for scans only costs nothing.
+   */
+  void LoadFreeSpaceMap();
+
+  /**
+   * @return a page with at least `bytes` free according to the map, the best fit, INVALID_PAGE_ID if none
+   */
+  page_id_t FindPageWithFreeSpace(uint32_t bytes);
+
+  /**
+   * Record the free bytes of a table page, the map page is only written when the category changes. A page the map
+   * does not know yet is appended to it.
+   */
+  void RecordFreeSpace(page_id_t page_id, uint32_t free_bytes);
+
+  /**
+   * Drop a page freed from the table from the map.
+   */
+  void ForgetFreeSpace(page_id_t page_id);
+
+  /**
+   * Location and category of the entry of a table page in the free space map.
+   */
+  struct FreeSpaceEntry {
+    page_id_t map_page_id_;
+    uint32_t slot_;
+    uint8_t category_;
+  };
+
  private:
   BufferPoolManager *buffer_pool_manager_;
   page_id_t first_page_id_;
-  page_id_t last_page_id;
-  uint32_t total_page{0};
+  page_id_t fsm_page_id_{INVALID_PAGE_ID};
   Schema *schema_;
+  TableLayout layout_{TableLayout::kRow};
+  // whether the rows of the table may refer to overflow pages
+  bool has_long_columns_{false};
   [[maybe_unused]] LogManager *log_manager_;
   [[maybe_unused]] LockManager *lock_manager_;
+  AccessStats access_stats_;
+  // contiguous pages the table pages are allocated from
+  PageReservation reservation_;
+  // in-memory copy of the free space map, valid once loaded
+  bool fsm_loaded_{false};
+  page_id_t fsm_last_page_id_{INVALID_PAGE_ID};
+  page_id_t last_page_id_{INVALID_PAGE_ID};
+  std::unordered_map<page_id_t, FreeSpaceEntry> fsm_entries_;
+  std::set<std::pair<uint8_t, page_id_t>> fsm_by_category_;
 };
 
 #endif  // MINISQL_TABLE_HEAP_H
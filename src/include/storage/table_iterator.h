@@ -1,50 +1,104 @@
 #ifndef MINISQL_TABLE_ITERATOR_H
 #define MINISQL_TABLE_ITERATOR_H
 
+#include <vector>
+
 #include "common/rowid.h"
+#include "page/page.h"
 #include "record/row.h"
 #include "transaction/transaction.h"
 
 class TableHeap;
+class PaxPage;
+class BufferAccessStrategy;
+
+/**
+ * A tuple as it lies in the table page a TableIterator pins, valid until the iterator leaves the page. The tuple of a
+ * row page is one serialized run of bytes, the values of a tuple of a pax page are spread over its minipages.
+ */
+class RowView {
+ public:
+  /**
+   * @param heap the table heap the values in overflow pages are fetched from, nullptr to leave them unloaded
+   */
+  RowView(char *data, uint32_t size, RowId rid, TableHeap *heap = nullptr)
+      : data_(data), size_(size), heap_(heap), rid_(rid) {}
+
+  RowView(PaxPage *pax_page, RowId rid) : pax_page_(pax_page), rid_(rid) {}
+
+  inline RowId GetRowId() const { return rid_; }
+
+  /** @return the serialized tuple, nullptr for a tuple of a pax page */
+  inline const char *GetData() const { return data_; }
+
+  inline uint32_t GetSize() const { return size_; }
+
+  /**
+   * Deserialize the tuple into `row`, replacing its fields.
+   * @param columns the columns the caller reads, nullptr for all of them; only these are read, the others are NULL
+   */
+  void Materialize(Row *row, Schema *schema, const std::vector<uint32_t> *columns = nullptr) const;
 
+ private:
+  char *data_{nullptr};
+  uint32_t size_{0};
+  TableHeap *heap_{nullptr};
+  PaxPage *pax_page_{nullptr};
+  RowId rid_;
+};
+
+/**
+ * Scan cursor of a table heap. It keeps the page of the current tuple pinned and walks its slots in place, the page is
+ * unpinned when the cursor moves on to the next page or is destroyed. The current tuple is deserialized into a Row only
+ * on operator* or operator->, GetRowView() and GetRowId() never copy it.
+ */
 class TableIterator {
-public:
-  // you may define your own constructor based on your member variables
-  explicit TableIterator();
+ public:
+  TableIterator() = default;
 
-  explicit TableIterator(Row *row, TableHeap *this_heap, RowId &rid) : row_(row), this_heap_(this_heap), rid(rid){}
+  /**
+   * @param page the pinned page holding `rid`, the pin is handed over to the iterator; nullptr for the end iterator
+   */
+  explicit TableIterator(TableHeap *this_heap, Page *page, RowId rid, BufferAccessStrategy *strategy = nullptr)
+      : this_heap_(this_heap), page_(page), rid(rid), strategy_(strategy) {}
 
-  explicit TableIterator(const TableIterator &other);
+  TableIterator(const TableIterator &other);
+
+  TableIterator(TableIterator &&other) noexcept;
 
   virtual ~TableIterator();
 
-  inline bool operator==(const TableIterator &itr) const {return rid == itr.rid;}
+  inline bool operator==(const TableIterator &itr) const { return rid == itr.rid; }
 
-  inline bool operator!=(const TableIterator &itr) const {return !(rid == itr.rid);}
+  inline bool operator!=(const TableIterator &itr) const { return !(rid == itr.rid); }
 
   const Row &operator*();
 
   Row *operator->();
 
-  TableIterator &operator=(const TableIterator &itr) noexcept{
-    if (itr.row_) {
-      row_ = new Row(*itr.row_);
-    }
-    else row_ = nullptr;
-    this_heap_ = itr.this_heap_;
-    rid = itr.rid;
-    return *this;
-  }
+  TableIterator &operator=(const TableIterator &itr);
+
+  TableIterator &operator=(TableIterator &&itr) noexcept;
 
   TableIterator &operator++();
 
   TableIterator operator++(int);
 
-private:
-  Row *row_{nullptr};
+  inline RowId GetRowId() const { return rid; }
+
+  RowView GetRowView() const;
+
+ private:
+  /** Unpin the current page, if any */
+  void Release();
+
   TableHeap *this_heap_{nullptr};
+  Page *page_{nullptr};
   RowId rid{INVALID_PAGE_ID, 0};
-  // add your own private member variables here
+  BufferAccessStrategy *strategy_{nullptr};  // ring the scan reads its pages through, nullptr for the shared pool
+  /** The current tuple, deserialized on first access */
+  Row row_;
+  bool materialized_{false};
 };
 
 #endif  // MINISQL_TABLE_ITERATOR_H
@@ -26,6 +26,10 @@ BPlusTree::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager
   buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
   buffer_pool_manager_->UnpinPage(root_page_id_, true);
 }
+
+BPlusTree::~BPlusTree() {
+  buffer_pool_manager_->ReleaseReservation(&reservation_);
+}
 /*
  * If current_page_id = INVALID_PAGE_ID, then
  * destroy from the root page, otherwise
@@ -38,6 +42,7 @@ void BPlusTree::Destroy(page_id_t current_page_id) {
     current_page_id = root_page_id_;
     root_page_id_ = INVALID_PAGE_ID;
     UpdateRootPageId(2);
+    buffer_pool_manager_->ReleaseReservation(&reservation_);
   }
   auto page = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(current_page_id)->GetData());
   if(!page->IsLeafPage()) {
@@ -67,6 +72,7 @@ bool BPlusTree::IsEmpty() const {
  * @return : true means key exists
  */
 bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Transaction *transaction) {
+  StatsScope scope(&access_stats_);
   if(IsEmpty()) return false;
   auto *page = FindLeafPage(key, INVALID_PAGE_ID, false);
   if(page == nullptr) {
@@ -93,6 +99,7 @@ bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Tran
  * keys return false, otherwise return true.
  */
 bool BPlusTree::Insert(GenericKey *key, const RowId &value, Transaction *transaction) {
+  StatsScope scope(&access_stats_);
   if(IsEmpty()) {
 //    LOG(INFO) << "BPlusTree::Insert the first key" << std::endl;
     StartNewTree(key, value);
@@ -109,12 +116,12 @@ bool BPlusTree::Insert(GenericKey *key, const RowId &value, Transaction *transac
  * tree's root page id and insert entry directly into leaf page.
  */
 void BPlusTree::StartNewTree(GenericKey *key, const RowId &value) {
-  auto * page = buffer_pool_manager_->NewPage(root_page_id_);
+  auto * page = buffer_pool_manager_->NewPage(root_page_id_, &reservation_);
   if(page == nullptr) {
 //    LOG(ERROR) << "out of memory" << std::endl;
   }
   auto * leaf = reinterpret_cast<LeafPage *>(page->GetData());
-  leaf_max_size_ = 4064/(processor_.GetKeySize() + sizeof(value))-1;
+  leaf_max_size_ = (PAGE_USABLE_SIZE - LEAF_PAGE_HEADER_SIZE)/(processor_.GetKeySize() + sizeof(value))-1;
   internal_max_size_ =  leaf_max_size_;
   if(internal_max_size_ < 2) {
     internal_max_size_ = 2, leaf_max_size_ = 2;
@@ -162,12 +169,12 @@ bool BPlusTree::InsertIntoLeaf(GenericKey *key, const RowId &value, Transaction
  */
 BPlusTreeInternalPage *BPlusTree::Split(InternalPage *node, Transaction *transaction) {
   page_id_t new_page_id;
-  auto *page = buffer_pool_manager_->NewPage(new_page_id);
+  auto *page = buffer_pool_manager_->NewPage(new_page_id, &reservation_);
   if(page == nullptr) {
 //    LOG(ERROR) << "out of memory" << std::endl;
     return nullptr;
   }
-  BPlusTreeInternalPage *new_page = reinterpret_cast<InternalPage *>(page);
+  BPlusTreeInternalPage *new_page = reinterpret_cast<InternalPage *>(page->GetData());
   new_page->Init(new_page_id, node->GetParentPageId(), node->GetKeySize(), node->GetMaxSize());
   node->MoveHalfTo(new_page, buffer_pool_manager_);
   return new_page;
@@ -175,12 +182,12 @@ BPlusTreeInternalPage *BPlusTree::Split(InternalPage *node, Transaction *transac
 
 BPlusTreeLeafPage *BPlusTree::Split(LeafPage *node, Transaction *transaction) {
   page_id_t new_page_id;
-  auto *page = buffer_pool_manager_->NewPage(new_page_id);
+  auto *page = buffer_pool_manager_->NewPage(new_page_id, &reservation_);
   if(page == nullptr) {
 //    LOG(ERROR) << "out of memory" << std::endl;
     return nullptr;
   }
-  BPlusTreeLeafPage *new_page = reinterpret_cast<LeafPage *>(page);
+  BPlusTreeLeafPage *new_page = reinterpret_cast<LeafPage *>(page->GetData());
   new_page->Init(new_page_id, node->GetParentPageId(), node->GetKeySize(),node->GetMaxSize());
   node->MoveHalfTo(new_page);
   return new_page;
@@ -198,7 +205,7 @@ BPlusTreeLeafPage *BPlusTree::Split(LeafPage *node, Transaction *transaction) {
 void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlusTreePage *new_node,
                                  Transaction *transaction) {
   if(old_node->IsRootPage()) {
-    auto *page = buffer_pool_manager_->NewPage(root_page_id_);
+    auto *page = buffer_pool_manager_->NewPage(root_page_id_, &reservation_);
     if(page == nullptr) {
 //      LOG(ERROR) << "Out of memory." << std::endl;
     }
@@ -233,6 +240,7 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
  * necessary.
  */
 void BPlusTree::Remove(const GenericKey *key, Transaction *transaction) {
+  StatsScope scope(&access_stats_);
   if(IsEmpty()) return;
   auto * leaf = reinterpret_cast<LeafPage *>
       (FindLeafPage(key, INVALID_PAGE_ID,false)->GetData());
@@ -400,10 +408,11 @@ bool BPlusTree::AdjustRoot(BPlusTreePage *old_root_node) {
  * @return : index iterator
  */
 IndexIterator BPlusTree::Begin() {
+  StatsScope scope(&access_stats_);
   auto * page = reinterpret_cast<LeafPage *>(FindLeafPage(nullptr, INVALID_PAGE_ID, true)->GetData());
   page_id_t page_id = page->GetPageId();
   buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
-  return IndexIterator(page_id, buffer_pool_manager_, 0);
+  return IndexIterator(page_id, buffer_pool_manager_, 0, &access_stats_);
 }
 
 /*
@@ -412,11 +421,12 @@ IndexIterator BPlusTree::Begin() {
  * @return : index iterator
  */
 IndexIterator BPlusTree::Begin(const GenericKey *key) {
+   StatsScope scope(&access_stats_);
    auto * page = reinterpret_cast<LeafPage *>(FindLeafPage(key, INVALID_PAGE_ID, false)->GetData());
    int index = page->KeyIndex(key, processor_);
    page_id_t page_id = page->GetPageId();
    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
-   return IndexIterator(page_id, buffer_pool_manager_, index);
+   return IndexIterator(page_id, buffer_pool_manager_, index, &access_stats_);
 }
 
 /*
@@ -437,7 +447,7 @@ IndexIterator BPlusTree::End() {
 //   }
 //   int page_id = page->GetPageId(), index = page->GetSize()-1;
 //   buffer_pool_manager_->UnpinPage(page_id, false);
-//   return IndexIterator(page_id, buffer_pool_manager_, index);
+//   return IndexIterator(page_id, buffer_pool_manager_, index, &access_stats_);
    // End() = default;
     return IndexIterator();
 }
@@ -452,17 +462,17 @@ IndexIterator BPlusTree::End() {
  */
 Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool leftMost) {
    if(page_id == INVALID_PAGE_ID) page_id = root_page_id_;
-  auto * page = reinterpret_cast<BPlusTreePage *>
-      (buffer_pool_manager_->FetchPage(page_id)->GetData());
+  Page *frame = buffer_pool_manager_->FetchPage(page_id);
+  auto * page = reinterpret_cast<BPlusTreePage *>(frame->GetData());
   while(!page->IsLeafPage()) {
     auto inner = reinterpret_cast<InternalPage *>(page);
     page_id_t child_id = leftMost ? inner->ValueAt(0) : inner->Lookup(key, processor_);
-    auto child_page = reinterpret_cast<BPlusTreePage *>
-        (buffer_pool_manager_->FetchPage(child_id)->GetData());
+    Page *child_frame = buffer_pool_manager_->FetchPage(child_id);
     buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
-    page = child_page;
+    frame = child_frame;
+    page = reinterpret_cast<BPlusTreePage *>(frame->GetData());
   }
-  return reinterpret_cast<Page *>(page);
+  return frame;
 }
 
 /*
@@ -27,7 +27,7 @@ bool HashTable::Insert(GenericKey *key, const RowId &value, Transaction *transac
       return false;
     }
     page_id_[key_v] = page_id;
-    int max_size = (PAGE_SIZE - HASH_PAGE_HEADER_SIZE) / (processor_.GetKeySize() + sizeof(value));
+    int max_size = (PAGE_USABLE_SIZE - HASH_PAGE_HEADER_SIZE) / (processor_.GetKeySize() + sizeof(value));
     page->Init(page_id, INVALID_PAGE_ID, processor_.GetKeySize(), max_size);
   }
   else {
@@ -5,9 +5,11 @@
 
 IndexIterator::IndexIterator() = default;
 
-IndexIterator::IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index)
-    : current_page_id(page_id), item_index(index), buffer_pool_manager(bpm) {
+IndexIterator::IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index, AccessStats *stats)
+    : current_page_id(page_id), item_index(index), buffer_pool_manager(bpm), stats_(stats) {
+  StatsScope scope(stats_);
   page = reinterpret_cast<LeafPage *>(buffer_pool_manager->FetchPage(current_page_id)->GetData());
+  buffer_pool_manager->ReadAhead(current_page_id, page->GetNextPageId());
 }
 
 IndexIterator::~IndexIterator() {
@@ -25,12 +27,14 @@ IndexIterator &IndexIterator::operator++() {
 //  ++rx; LOG(INFO) << "rx = " << rx ;
   if(++item_index == page->GetSize() && page->GetNextPageId() != INVALID_PAGE_ID) {
 //    LOG(INFO) << "IndexIterator : move to right page";
+    StatsScope scope(stats_);
     auto * next_page = reinterpret_cast<::LeafPage *>
         (buffer_pool_manager->FetchPage(page->GetNextPageId())->GetData());
     current_page_id = page->GetNextPageId();
 //    LOG(INFO) << "before : ";
     buffer_pool_manager->UnpinPage(page->GetPageId(), false);
     page = next_page;
+    buffer_pool_manager->ReadAhead(current_page_id, page->GetNextPageId());
 //    LOG(INFO) << "after : ";
     item_index = 0;
   } if(item_index == page->GetSize()) {
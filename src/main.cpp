@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <string>
 
 #include "executor/execute_engine.h"
 #include "glog/logging.h"
@@ -19,23 +20,29 @@ void InitGoogleLog(char *argv) {
   // LOG(INFO) << "glog started!";
 }
 
-void InputCommand(char *input, const int len) {
-  memset(input, 0, len);
+/**
+ * Read one statement up to its ';', a statement may be of any length, e.g. an insert of many tuples.
+ * @return false at the end of the input
+ */
+bool InputCommand(std::string &input) {
+  input.clear();
   printf("minisql > ");
-  int i = 0;
-  char ch;
+  int ch;
   while ((ch = getchar()) != ';') {
-    input[i++] = ch;
+    if (ch == EOF) {
+      return false;
+    }
+    input.push_back(static_cast<char>(ch));
   }
-  input[i] = ch;  // ;
-  getchar();      // remove enter
+  input.push_back(';');
+  getchar();  // remove enter
+  return true;
 }
 
 int main(int argc, char **argv) {
   InitGoogleLog(argv[0]);
   // command buffer
-  const int buf_size = 1024;
-  char cmd[buf_size];
+  std::string cmd;
   // executor engine
   ExecuteEngine engine;
   // for print syntax tree
@@ -44,9 +51,11 @@ int main(int argc, char **argv) {
 
   while (1) {
     // read from buffer
-    InputCommand(cmd, buf_size);
+    if (!InputCommand(cmd)) {
+      break;
+    }
     // create buffer for sql input
-    YY_BUFFER_STATE bp = yy_scan_string(cmd);
+    YY_BUFFER_STATE bp = yy_scan_string(cmd.c_str());
     if (bp == nullptr) {
       LOG(ERROR) << "Failed to create yy buffer state." << std::endl;
       exit(1);
@@ -34,6 +34,38 @@ bool BitmapPage<PageSize>::AllocatePage(uint32_t &page_offset) {
   }
 }
 
+template <size_t PageSize>
+bool BitmapPage<PageSize>::AllocatePages(uint32_t count, uint32_t &page_offset) {
+  if (count == 0 || page_allocated_ + count > GetMaxSupportedSize()) {
+    return false;
+  }
+  if (!FindFreeRun(next_free_page_, count, page_offset) && !FindFreeRun(0, count, page_offset)) {
+    return false;
+  }
+  for (uint32_t i = page_offset; i < page_offset + count; i++) {
+    bytes[i / 8] |= '\01' << (i % 8);
+  }
+  page_allocated_ += count;
+  UpdateNextFreePage();
+  return true;
+}
+
+template <size_t PageSize>
+bool BitmapPage<PageSize>::FindFreeRun(uint32_t from, uint32_t count, uint32_t &page_offset) const {
+  uint32_t run = 0;
+  for (uint32_t i = from; i < GetMaxSupportedSize(); i++) {
+    if (!IsPageFree(i)) {
+      run = 0;
+      continue;
+    }
+    if (++run == count) {
+      page_offset = i + 1 - count;
+      return true;
+    }
+  }
+  return false;
+}
+
 /**
  * TODO: Student Implement
  */
@@ -118,4 +150,6 @@ template class BitmapPage<1024>;
 
 template class BitmapPage<2048>;
 
-template class BitmapPage<4096>;
\ No newline at end of file
+template class BitmapPage<4096>;
+
+template class BitmapPage<PAGE_USABLE_SIZE>;
\ No newline at end of file
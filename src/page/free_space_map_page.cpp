@@ -0,0 +1,21 @@
+#include "page/free_space_map_page.h"
+
+#include "common/macros.h"
+
+void FreeSpaceMapPage::Init() {
+  next_page_id_ = INVALID_PAGE_ID;
+  entry_count_ = 0;
+}
+
+uint32_t FreeSpaceMapPage::Append(page_id_t page_id, uint8_t category) {
+  ASSERT(!IsFull(), "Free space map page is full.");
+  page_ids_[entry_count_] = page_id;
+  categories_[entry_count_] = category;
+  return entry_count_++;
+}
+
+void FreeSpaceMapPage::Remove(uint32_t slot) {
+  ASSERT(slot < entry_count_, "Invalid free space map slot.");
+  page_ids_[slot] = INVALID_PAGE_ID;
+  categories_[slot] = 0;
+}
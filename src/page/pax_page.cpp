@@ -0,0 +1,233 @@
+#include "page/pax_page.h"
+
+uint32_t PaxPage::GetValueWidth(const Column *column) {
+  if (column->GetType() == TypeId::kTypeChar) {
+    return sizeof(uint32_t) + column->GetLength();
+  }
+  return Type::GetTypeSize(column->GetType());
+}
+
+uint32_t PaxPage::ComputeCapacity(const Schema *schema) {
+  uint32_t column_count = schema->GetColumnCount();
+  uint32_t row_width = 0;
+  for (auto column : schema->GetColumns()) {
+    row_width += GetValueWidth(column);
+  }
+  auto page_size = [&](uint32_t capacity) {
+    return GetHeaderSize(column_count, capacity) + column_count * ((capacity + 7) / 8) + capacity * row_width;
+  };
+  if (page_size(0) >= PAGE_USABLE_SIZE) {
+    return 0;
+  }
+  // every slot takes its state byte, its values and at least one bit in each bitmap
+  uint32_t capacity = (PAGE_USABLE_SIZE - page_size(0)) / (row_width + 1);
+  while (capacity > 0 && page_size(capacity) > PAGE_USABLE_SIZE) {
+    capacity--;
+  }
+  return capacity;
+}
+
+bool PaxPage::RowFits(const Row &row, const Schema *schema) {
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    const Column *column = schema->GetColumn(i);
+    const Field *field = row.GetField(i);
+    if (column->GetType() == TypeId::kTypeChar && !field->IsNull() && field->GetLength() > column->GetLength()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PaxPage::Init(page_id_t page_id, page_id_t prev_id, const Schema *schema, LogManager *log_mgr,
+                   Transaction *txn) {
+  memcpy(GetData(), &page_id, sizeof(page_id));
+  SetPrevPageId(prev_id);
+  SetNextPageId(INVALID_PAGE_ID);
+  uint32_t capacity = ComputeCapacity(schema);
+  ASSERT(capacity > 0, "A row of the schema does not fit a pax page.");
+  uint32_t column_count = schema->GetColumnCount();
+  memcpy(GetData() + OFFSET_CAPACITY, &capacity, sizeof(uint32_t));
+  SetSlotCount(0);
+  SetUsedCount(0);
+  memcpy(GetData() + OFFSET_COLUMN_COUNT, &column_count, sizeof(uint32_t));
+  uint32_t offset = GetHeaderSize(column_count, capacity);
+  for (uint32_t i = 0; i < column_count; i++) {
+    memcpy(GetData() + OFFSET_MINIPAGE_OFFSETS + sizeof(uint32_t) * i, &offset, sizeof(uint32_t));
+    offset += (capacity + 7) / 8 + capacity * GetValueWidth(schema->GetColumn(i));
+  }
+  memset(GetSlotStates(), SLOT_EMPTY, capacity);
+}
+
+void PaxPage::WriteRow(uint32_t slot_num, const Row &row, const Schema *schema) {
+  for (uint32_t i = 0; i < GetColumnCount(); i++) {
+    char *minipage = GetData() + GetMinipageOffset(i);
+    const Field *field = row.GetField(i);
+    uint8_t mask = 1 << (slot_num % 8);
+    if (field->IsNull()) {
+      minipage[slot_num / 8] |= mask;
+      continue;
+    }
+    minipage[slot_num / 8] &= ~mask;
+    uint32_t width = GetValueWidth(schema->GetColumn(i));
+    field->SerializeTo(minipage + (GetCapacity() + 7) / 8 + slot_num * width);
+  }
+}
+
+Field *PaxPage::ReadField(uint32_t slot_num, uint32_t column, const Schema *schema, MemoryArena *arena) {
+  char *minipage = GetData() + GetMinipageOffset(column);
+  TypeId type = schema->GetColumn(column)->GetType();
+  bool is_null = (minipage[slot_num / 8] & (1 << (slot_num % 8))) != 0;
+  uint32_t width = GetValueWidth(schema->GetColumn(column));
+  char *value = minipage + (GetCapacity() + 7) / 8 + slot_num * width;
+  if (arena == nullptr) {
+    Field *field = nullptr;
+    Field::DeserializeFrom(value, type, &field, is_null);
+    return field;
+  }
+  // the field is built in the arena straight from the minipage bytes, which are laid out as Type::SerializeTo writes them
+  if (is_null) {
+    return arena->New<Field>(type);
+  }
+  switch (type) {
+    case TypeId::kTypeInt:
+      return arena->New<Field>(type, MACH_READ_INT32(value));
+    case TypeId::kTypeFloat:
+      return arena->New<Field>(type, MACH_READ_FROM(float, value));
+    default: {
+      uint32_t len = MACH_READ_UINT32(value);
+      if (len & TypeChar::OVERFLOW_FLAG) {
+        return arena->New<Field>(type, len & ~TypeChar::OVERFLOW_FLAG,
+                                 MACH_READ_FROM(page_id_t, value + sizeof(uint32_t)));
+      }
+      const char *chars = value + sizeof(uint32_t);
+      return arena->New<Field>(type, chars, len, arena);
+    }
+  }
+}
+
+bool PaxPage::InsertTuple(Row &row, Schema *schema, Transaction *txn, LockManager *lock_manager,
+                          LogManager *log_manager) {
+  ASSERT(RowFits(row, schema), "Row does not fit the columns of a pax page.");
+  if (GetUsedCount() == GetCapacity()) {
+    return false;
+  }
+  // reuse the first empty slot, the slots past the slot count are all empty
+  uint32_t i = 0;
+  while (i < GetSlotCount() && GetSlotState(i) != SLOT_EMPTY) {
+    i++;
+  }
+  row.SetRowId(RowId(GetTablePageId(), i));
+  WriteRow(i, row, schema);
+  SetSlotState(i, SLOT_LIVE);
+  SetUsedCount(GetUsedCount() + 1);
+  if (i == GetSlotCount()) {
+    SetSlotCount(i + 1);
+  }
+  return true;
+}
+
+bool PaxPage::MarkDelete(const RowId &rid, Transaction *txn, LockManager *lock_manager, LogManager *log_manager) {
+  uint32_t slot_num = rid.GetSlotNum();
+  if (!IsLive(slot_num)) {
+    return false;
+  }
+  SetSlotState(slot_num, SLOT_DELETED);
+  return true;
+}
+
+int PaxPage::UpdateTuple(const Row &new_row, Row *old_row, Schema *schema, Transaction *txn,
+                         LockManager *lock_manager, LogManager *log_manager) {
+  ASSERT(old_row != nullptr && old_row->GetRowId().Get() != INVALID_ROWID.Get(), "invalid old row.");
+  ASSERT(RowFits(new_row, schema), "Row does not fit the columns of a pax page.");
+  uint32_t slot_num = old_row->GetRowId().GetSlotNum();
+  if (slot_num >= GetSlotCount() || GetSlotState(slot_num) == SLOT_EMPTY) {
+    return -1;
+  }
+  if (GetSlotState(slot_num) == SLOT_DELETED) {
+    return -2;
+  }
+  // Copy out the old value.
+  old_row->destroy();
+  for (uint32_t i = 0; i < GetColumnCount(); i++) {
+    old_row->GetFields().push_back(ReadField(slot_num, i, schema, old_row->GetArena()));
+  }
+  WriteRow(slot_num, new_row, schema);
+  return 1;
+}
+
+void PaxPage::ApplyDelete(const RowId &rid, Transaction *txn, LogManager *log_manager) {
+  uint32_t slot_num = rid.GetSlotNum();
+  ASSERT(slot_num < GetSlotCount() && GetSlotState(slot_num) != SLOT_EMPTY, "Cannot delete an empty slot.");
+  SetSlotState(slot_num, SLOT_EMPTY);
+  SetUsedCount(GetUsedCount() - 1);
+  // trailing empty slots are given back, so that a scan stops at the last tuple
+  uint32_t slot_count = GetSlotCount();
+  while (slot_count > 0 && GetSlotState(slot_count - 1) == SLOT_EMPTY) {
+    slot_count--;
+  }
+  SetSlotCount(slot_count);
+}
+
+void PaxPage::RollbackDelete(const RowId &rid, Transaction *txn, LogManager *log_manager) {
+  uint32_t slot_num = rid.GetSlotNum();
+  ASSERT(slot_num < GetSlotCount(), "We can't have more slots than tuples.");
+  if (GetSlotState(slot_num) == SLOT_DELETED) {
+    SetSlotState(slot_num, SLOT_LIVE);
+  }
+}
+
+bool PaxPage::GetTuple(Row *row, Schema *schema, Transaction *txn, LockManager *lock_manager) {
+  ASSERT(row != nullptr && row->GetRowId().Get() != INVALID_ROWID.Get(), "Invalid row.");
+  uint32_t slot_num = row->GetRowId().GetSlotNum();
+  if (!IsLive(slot_num)) {
+    return false;
+  }
+  row->destroy();
+  for (uint32_t i = 0; i < GetColumnCount(); i++) {
+    row->GetFields().push_back(ReadField(slot_num, i, schema, row->GetArena()));
+  }
+  return true;
+}
+
+void PaxPage::ReadColumns(uint32_t slot_num, const Schema *schema, const std::vector<uint32_t> &columns, Row *row) {
+  ASSERT(IsLive(slot_num), "Cannot read the columns of a deleted tuple.");
+  row->destroy();
+  auto &fields = row->GetFields();
+  for (uint32_t i = 0; i < GetColumnCount(); i++) {
+    fields.push_back(nullptr);
+  }
+  for (auto column : columns) {
+    if (fields[column] == nullptr) {
+      fields[column] = ReadField(slot_num, column, schema, row->GetArena());
+    }
+  }
+  for (uint32_t i = 0; i < GetColumnCount(); i++) {
+    if (fields[i] == nullptr) {
+      TypeId type = schema->GetColumn(i)->GetType();
+      fields[i] = row->GetArena() != nullptr ? row->GetArena()->New<Field>(type) : new Field(type);
+    }
+  }
+}
+
+bool PaxPage::GetFirstTupleRid(RowId *first_rid) {
+  for (uint32_t i = 0; i < GetSlotCount(); i++) {
+    if (GetSlotState(i) == SLOT_LIVE) {
+      first_rid->Set(GetTablePageId(), i);
+      return true;
+    }
+  }
+  first_rid->Set(INVALID_PAGE_ID, 0);
+  return false;
+}
+
+bool PaxPage::GetNextTupleRid(const RowId &cur_rid, RowId *next_rid) {
+  ASSERT(cur_rid.GetPageId() == GetTablePageId(), "Wrong table!");
+  for (auto i = cur_rid.GetSlotNum() + 1; i < GetSlotCount(); i++) {
+    if (GetSlotState(i) == SLOT_LIVE) {
+      next_rid->Set(GetTablePageId(), i);
+      return true;
+    }
+  }
+  next_rid->Set(INVALID_PAGE_ID, 0);
+  return false;
+}
@@ -4,7 +4,7 @@ void TablePage::Init(page_id_t page_id, page_id_t prev_id, LogManager *log_mgr,
   memcpy(GetData(), &page_id, sizeof(page_id));
   SetPrevPageId(prev_id);
   SetNextPageId(INVALID_PAGE_ID);
-  SetFreeSpacePointer(PAGE_SIZE);
+  SetFreeSpacePointer(PAGE_USABLE_SIZE);
   SetTupleCount(0);
 }
 
@@ -119,8 +119,8 @@ void TablePage::ApplyDelete(const RowId &rid, Transaction *txn, LogManager *log_
   memmove(GetData() + free_space_pointer + tuple_size, GetData() + free_space_pointer,
           tuple_offset - free_space_pointer);
   SetFreeSpacePointer(free_space_pointer + tuple_size);
+  // the slot stays, empty, for InsertTuple to reuse, the rids of the other tuples must not move
   SetTupleSize(slot_num, 0);
-  SetTupleCount(GetTupleCount() - 1);
   SetTupleOffsetAtSlot(slot_num, 0);
 
   // Update all tuple offsets.
@@ -164,6 +164,15 @@ bool TablePage::GetTuple(Row *row, Schema *schema, Transaction *txn, LockManager
   return true;
 }
 
+char *TablePage::GetTupleData(uint32_t slot_num, uint32_t *tuple_size, bool include_deleted) {
+  if (slot_num >= GetTupleCount() || GetTupleSize(slot_num) == 0 ||
+      (IsDeleted(GetTupleSize(slot_num)) && !include_deleted)) {
+    return nullptr;
+  }
+  *tuple_size = UnsetDeletedFlag(GetTupleSize(slot_num));
+  return GetData() + GetTupleOffsetAtSlot(slot_num);
+}
+
 bool TablePage::GetFirstTupleRid(RowId *first_rid) {
   // Find and return the first valid tuple.
   for (uint32_t i = 0; i < GetTupleCount(); i++) {
@@ -129,8 +129,12 @@ const char *GetSyntaxNodeTypeStr(SyntaxNodeType type) {
       return "kNodeDropTable";
     case kNodeShowIndexes:
       return "kNodeShowIndexes";
+    case kNodeShowStatus:
+      return "kNodeShowStatus";
     case kNodeInsert:
       return "kNodeInsert";
+    case kNodeCopy:
+      return "kNodeCopy";
     case kNodeDelete:
       return "kNodeDelete";
     case kNodeUpdate:
@@ -163,6 +167,8 @@ const char *GetSyntaxNodeTypeStr(SyntaxNodeType type) {
       return "kNodeCreateIndex";
     case kNodeDropIndex:
       return "kNodeDropIndex";
+    case kNodeTableOption:
+      return "kNodeTableOption";
     case kNodeTrxBegin:
       return "kNodeTrxBegin";
     case kNodeTrxCommit:
@@ -1,5 +1,7 @@
 #include "record/row.h"
 
+#include <utility>
+
 /**
  * Student added functions about null bitmap in serialization.
  */
@@ -32,75 +34,188 @@ bool SetNull(unsigned char *bitmap, size_t num) {
 }
 
 
-/**
- * TODO: Student Implement
- */
+namespace {
+
+constexpr uint8_t ROW_FORMAT_VERSION = 1;
+constexpr uint16_t VAR_OVERFLOW_FLAG = 0x8000;  // high bit of an entry of the offset array
+
+uint32_t GetFixedOffset(const Schema *schema) { return sizeof(uint8_t) + (schema->GetColumnCount() + 7) / 8; }
+
+uint32_t GetVarEndsOffset(const Schema *schema) { return GetFixedOffset(schema) + schema->GetFixedSize(); }
+
+uint32_t GetVarDataOffset(const Schema *schema) {
+  return GetVarEndsOffset(schema) + sizeof(uint16_t) * schema->GetVarColumnCount();
+}
+
+/** @return the end of the value of the var_index-th CHAR column, relative to the var data */
+uint16_t GetVarEnd(const char *buf, const Schema *schema, uint32_t var_index) {
+  return MACH_READ_FROM(uint16_t, buf + GetVarEndsOffset(schema) + sizeof(uint16_t) * var_index);
+}
+
+uint32_t GetRowSize(const char *buf, const Schema *schema) {
+  uint32_t var_count = schema->GetVarColumnCount();
+  uint32_t var_size = var_count == 0 ? 0 : GetVarEnd(buf, schema, var_count - 1) & ~VAR_OVERFLOW_FLAG;
+  return GetVarDataOffset(schema) + var_size;
+}
+
+template <typename... Args>
+Field *NewField(MemoryArena *arena, Args &&...args) {
+  if (arena != nullptr) {
+    return arena->New<Field>(std::forward<Args>(args)...);
+  }
+  return new Field(std::forward<Args>(args)...);
+}
+
+}  // namespace
+
 uint32_t Row::SerializeTo(char *buf, Schema *schema) const {
   ASSERT(schema != nullptr, "Invalid schema before serialize.");
   ASSERT(schema->GetColumnCount() == fields_.size(), "Fields size do not match schema's column size.");
-  size_t fieldNum = schema->GetColumnCount();
-  uint32_t size = 0;
-  MACH_WRITE_TO(RowId, buf + size, this->rid_);
-  size += sizeof this->rid_;
-  MACH_WRITE_TO(size_t, buf + size, fieldNum);
-  size_t bitmapSize = (fieldNum - 1) / 8 + 1;
-  size += sizeof fieldNum;
-  auto bitmap = new unsigned char[bitmapSize];
-  for (size_t i = 0; i < fieldNum; ++i) {
-    if (fields_[i]->IsNull()) {
-      NullBitmap::SetNull(bitmap, i);
-    } else {
+  MACH_WRITE_TO(uint8_t, buf, ROW_FORMAT_VERSION);
+  auto bitmap = reinterpret_cast<unsigned char *>(buf + sizeof(uint8_t));
+  memset(bitmap, 0, GetFixedOffset(schema) - sizeof(uint8_t));
+  char *fixed = buf + GetFixedOffset(schema);
+  char *var_ends = buf + GetVarEndsOffset(schema);
+  char *var_data = buf + GetVarDataOffset(schema);
+  uint32_t var_size = 0;
+  for (uint32_t i = 0; i < fields_.size(); i++) {
+    const Field *field = fields_[i];
+    if (!field->IsNull()) {
       NullBitmap::SetNotNull(bitmap, i);
     }
+    if (schema->IsFixedWidth(i)) {
+      if (field->IsNull()) {
+        memset(fixed + schema->GetRowOffset(i), 0, Type::GetTypeSize(field->GetTypeId()));
+      } else {
+        field->SerializeTo(fixed + schema->GetRowOffset(i));
+      }
+      continue;
+    }
+    uint16_t flag = 0;
+    if (field->IsOverflow()) {
+      MACH_WRITE_UINT32(var_data + var_size, field->GetLength());
+      MACH_WRITE_TO(page_id_t, var_data + var_size + sizeof(uint32_t), field->GetOverflowPageId());
+      var_size += sizeof(uint32_t) + sizeof(page_id_t);
+      flag = VAR_OVERFLOW_FLAG;
+    } else if (!field->IsNull()) {
+      memcpy(var_data + var_size, field->GetData(), field->GetLength());
+      var_size += field->GetLength();
+    }
+    ASSERT(var_size < VAR_OVERFLOW_FLAG, "Row too large to serialize.");
+    uint16_t var_end = static_cast<uint16_t>(var_size) | flag;
+    MACH_WRITE_TO(uint16_t, var_ends + sizeof(uint16_t) * schema->GetRowOffset(i), var_end);
   }
-  for (size_t i = 0; i < bitmapSize; ++i) {
-    MACH_WRITE_TO(unsigned char, buf + size + i * sizeof(unsigned char), bitmap[i]);
-  }
-  size += sizeof(unsigned char) * bitmapSize;
-  for (auto i: fields_) {
-    if (i->IsNull()) continue;
-    size += i->SerializeTo(buf + size);
-  }
-  return size;
+  return GetVarDataOffset(schema) + var_size;
 }
 
 uint32_t Row::DeserializeFrom(char *buf, Schema *schema) {
   ASSERT(schema != nullptr, "Invalid schema before serialize.");
   ASSERT(fields_.empty(), "Non empty field in row.");
-  uint32_t size = 0;
-  this->rid_ = MACH_READ_FROM(RowId, buf + size);
-  size += sizeof this->rid_;
-  size_t fieldNum = MACH_READ_FROM(size_t, buf + size);
-  size += sizeof fieldNum;
-  size_t bitmapSize = (fieldNum - 1) / 8 + 1;
-  auto bitmap = new unsigned char [bitmapSize];
-  for (size_t i = 0; i < bitmapSize; ++i) {
-    bitmap[i] = MACH_READ_FROM(unsigned char, buf + size + i * sizeof(unsigned char));
-  }
-  size += sizeof(unsigned char) * bitmapSize;
-  for (int i = 0; i < fieldNum; ++i) {
-    fields_.push_back(nullptr);
-    if (NullBitmap::IsFieldNull(bitmap, i)) {
-      fields_[i] = new Field(schema->GetColumn(i)->GetType());
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    fields_.push_back(DeserializeField(buf, schema, i, arena_));
+  }
+  return GetRowSize(buf, schema);
+}
+
+uint32_t Row::DeserializeFrom(char *buf, Schema *schema, const std::vector<uint32_t> &columns) {
+  ASSERT(schema != nullptr, "Invalid schema before serialize.");
+  ASSERT(fields_.empty(), "Non empty field in row.");
+  fields_.resize(schema->GetColumnCount(), nullptr);
+  for (auto column : columns) {
+    if (fields_[column] == nullptr) {
+      fields_[column] = DeserializeField(buf, schema, column, arena_);
     }
-    else {
-      size += Field::DeserializeFrom(buf + size, schema->GetColumn(i)->GetType(), &fields_[i], false);
+  }
+  for (uint32_t i = 0; i < fields_.size(); i++) {
+    if (fields_[i] == nullptr) {
+      fields_[i] = NewField(arena_, schema->GetColumn(i)->GetType());
     }
   }
-  return size;
+  return GetRowSize(buf, schema);
+}
+
+Field *Row::DeserializeField(const char *buf, const Schema *schema, uint32_t column_index, MemoryArena *arena) {
+  ASSERT(MACH_READ_FROM(uint8_t, buf) == ROW_FORMAT_VERSION, "Unknown row format version.");
+  TypeId type = schema->GetColumn(column_index)->GetType();
+  auto bitmap = reinterpret_cast<unsigned char *>(const_cast<char *>(buf) + sizeof(uint8_t));
+  if (NullBitmap::IsFieldNull(bitmap, column_index)) {
+    return NewField(arena, type);
+  }
+  if (schema->IsFixedWidth(column_index)) {
+    const char *value = buf + GetFixedOffset(schema) + schema->GetRowOffset(column_index);
+    if (type == TypeId::kTypeInt) {
+      return NewField(arena, type, MACH_READ_INT32(value));
+    }
+    return NewField(arena, type, MACH_READ_FROM(float, value));
+  }
+  uint32_t var_index = schema->GetRowOffset(column_index);
+  uint16_t begin = var_index == 0 ? 0 : GetVarEnd(buf, schema, var_index - 1) & ~VAR_OVERFLOW_FLAG;
+  uint16_t end = GetVarEnd(buf, schema, var_index);
+  const char *value = buf + GetVarDataOffset(schema) + begin;
+  if (end & VAR_OVERFLOW_FLAG) {
+    return NewField(arena, type, MACH_READ_UINT32(value), MACH_READ_FROM(page_id_t, value + sizeof(uint32_t)));
+  }
+  uint32_t len = end - begin;
+  if (arena != nullptr) {
+    return arena->New<Field>(type, value, len, arena);
+  }
+  return new Field(type, const_cast<char *>(value), len, true);
 }
 
 uint32_t Row::GetSerializedSize(Schema *schema) const {
   ASSERT(schema != nullptr, "Invalid schema before serialize.");
   ASSERT(schema->GetColumnCount() == fields_.size(), "Fields size do not match schema's column size.");
-  uint32_t size = 0;
-  size += sizeof this->rid_ + sizeof (size_t) + ((schema->GetColumnCount() - 1) / 8 + 1);
-  for (auto i: fields_) {
-    size += i->GetSerializedSize();
+  uint32_t size = GetVarDataOffset(schema);
+  for (uint32_t i = 0; i < fields_.size(); i++) {
+    if (schema->IsFixedWidth(i)) {
+      continue;
+    }
+    if (fields_[i]->IsOverflow()) {
+      size += sizeof(uint32_t) + sizeof(page_id_t);
+    } else if (!fields_[i]->IsNull()) {
+      size += fields_[i]->GetLength();
+    }
   }
   return size;
 }
 
+void Row::ResizeFields(uint32_t count) {
+  if (fields_.size() == count) {
+    return;
+  }
+  destroy();
+  fields_.reserve(count);
+  for (uint32_t i = 0; i < count; i++) {
+    fields_.push_back(NewField(arena_, TypeId::kTypeInvalid));
+  }
+}
+
+void Row::SetField(uint32_t idx, const Field &field) {
+  ASSERT(idx < fields_.size(), "Failed to access field");
+  if (fields_[idx] != &field) {
+    // the old value is given back by the temporary it is swapped into
+    *fields_[idx] = CopyValue(field);
+  }
+}
+
+Field *Row::CopyField(const Field &field) const {
+  if (arena_ != nullptr) {
+    return arena_->New<Field>(CopyValue(field));
+  }
+  return new Field(CopyValue(field));
+}
+
+Field Row::CopyValue(const Field &field) const {
+  if (arena_ != nullptr) {
+    return Field(field, arena_);
+  }
+  // the copy owns its chars even if `field` only points to them
+  if (field.GetTypeId() == TypeId::kTypeChar && !field.IsNull() && !field.IsOverflow()) {
+    return Field(TypeId::kTypeChar, const_cast<char *>(field.GetData()), field.GetLength(), true);
+  }
+  return Field(field);
+}
+
 void Row::GetKeyFromRow(const Schema *schema, const Schema *key_schema, Row &key_row) {
   auto columns = key_schema->GetColumns();
   std::vector<Field> fields;
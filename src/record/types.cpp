@@ -226,6 +226,11 @@ CmpBool TypeFloat::CompareGreaterThanEquals(const Field &left, const Field &righ
 
 // ==============================TypeChar=============================
 uint32_t TypeChar::SerializeTo(const Field &field, char *buf) const {
+  if (field.IsOverflow()) {
+    MACH_WRITE_UINT32(buf, GetLength(field) | OVERFLOW_FLAG);
+    MACH_WRITE_TO(page_id_t, buf + sizeof(uint32_t), field.overflow_page_id_);
+    return sizeof(uint32_t) + sizeof(page_id_t);
+  }
   if (!field.IsNull()) {
     uint32_t len = GetLength(field);
     memcpy(buf, &len, sizeof(uint32_t));
@@ -241,6 +246,10 @@ uint32_t TypeChar::DeserializeFrom(char *storage, Field **field, bool is_null) c
     return 0;
   }
   uint32_t len = MACH_READ_UINT32(storage);
+  if (len & OVERFLOW_FLAG) {
+    *field = new Field(TypeId::kTypeChar, len & ~OVERFLOW_FLAG, MACH_READ_FROM(page_id_t, storage + sizeof(uint32_t)));
+    return sizeof(uint32_t) + sizeof(page_id_t);
+  }
   *field = new Field(TypeId::kTypeChar, storage + sizeof(uint32_t), len, true);
   return len + sizeof(uint32_t);
 }
@@ -249,6 +258,9 @@ uint32_t TypeChar::GetSerializedSize(const Field &field, bool is_null) const {
   if (is_null) {
     return 0;
   }
+  if (field.IsOverflow()) {
+    return sizeof(uint32_t) + sizeof(page_id_t);
+  }
   uint32_t len = GetLength(field);
   return len + sizeof(uint32_t);
 }
@@ -1,44 +1,103 @@
 #include "storage/disk_manager.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
 #include <filesystem>
 #include <stdexcept>
 
 #include "glog/logging.h"
 #include "page/bitmap_page.h"
+#include "storage/page_checksum.h"
 
-DiskManager::DiskManager(const std::string &db_file) : file_name_(db_file) {
-  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
-  db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-  // directory or file does not exist
-  if (!db_io_.is_open()) {
-    db_io_.clear();
-    // create a new file
-    std::filesystem::path p = db_file;
-    if(p.has_parent_path()) std::filesystem::create_directories(p.parent_path());
-    db_io_.open(db_file, std::ios::binary | std::ios::trunc | std::ios::out);
-    db_io_.close();
-    // reopen with original mode
-    db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-    if (!db_io_.is_open()) {
-      throw std::exception();
-    }
+DiskManager::DiskManager(const std::string &db_file, DiskAccessMode access_mode)
+    : file_name_(db_file), bitmaps_(EXTENT_SIZE) {
+  // directory does not exist
+  std::filesystem::path p = db_file;
+  if(p.has_parent_path()) std::filesystem::create_directories(p.parent_path());
+  db_fd_ = open(db_file.c_str(), O_RDWR | O_CREAT, 0644);
+  if (db_fd_ < 0) {
+    throw std::exception();
+  }
+  struct stat stat_buf;
+  if (fstat(db_fd_, &stat_buf) == 0) {
+    file_size_ = stat_buf.st_size;
   }
   ReadPhysicalPage(META_PAGE_ID, meta_data_);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  if (meta_page->IsNew()) {
+    meta_page->Init();
+  } else if (!meta_page->IsCompatible()) {
+    close(db_fd_);
+    if (meta_page->magic_num_ != DISK_FILE_MAGIC_NUM) {
+      throw std::runtime_error(db_file + " is not a database file");
+    }
+    throw std::runtime_error(db_file + " was created with page size " + std::to_string(meta_page->page_size_) +
+                             ", this build uses " + std::to_string(PAGE_SIZE));
+  }
+  if (access_mode == DiskAccessMode::kMemoryMapped) {
+    // reserve address space for every page the file can ever hold, so the mapping never has to move
+    size_t size = (1 + EXTENT_SIZE * (BITMAP_SIZE + 1)) * PAGE_SIZE;
+    void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_NORESERVE, db_fd_, 0);
+    if (mapping == MAP_FAILED) {
+      LOG(WARNING) << "Failed to map " << db_file << ", falling back to file I/O: " << strerror(errno);
+    } else {
+      mapping_ = static_cast<char *>(mapping);
+      mapping_size_ = size;
+    }
+  }
 }
 
 void DiskManager::Close() {
-  WritePhysicalPage(META_PAGE_ID, meta_data_);
-  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
-  if (!closed) {
-    db_io_.close();
-    closed = true;
+  if (closed) {
+    return;
   }
+  FlushMetaPage();
+  Sync();
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+  }
+  close(db_fd_);
+  closed = true;
 }
 
-void DiskManager::ReadPage(page_id_t logical_page_id, char *page_data) {
+void DiskManager::Sync() {
+  if (!needs_sync_.exchange(false)) {
+    return;
+  }
+  if (fdatasync(db_fd_) != 0) {
+    LOG(ERROR) << "I/O error while syncing: " << strerror(errno);
+    needs_sync_ = true;
+    return;
+  }
+  StatsAdd(num_flushes_);
+}
+
+void DiskManager::FlushMetaPage() {
+  std::scoped_lock<std::mutex> lock(meta_latch_);
+  FlushBitmaps();
+  WritePhysicalPage(META_PAGE_ID, meta_data_);
+}
+
+DiskStats DiskManager::GetStats() const {
+  DiskStats stats;
+  stats.reads_ = num_reads_.load(std::memory_order_relaxed);
+  stats.writes_ = num_writes_.load(std::memory_order_relaxed);
+  stats.bytes_read_ = stats.reads_ * PAGE_SIZE;
+  stats.bytes_written_ = stats.writes_ * PAGE_SIZE;
+  stats.flushes_ = num_flushes_.load(std::memory_order_relaxed);
+  stats.allocations_ = num_allocations_.load(std::memory_order_relaxed);
+  stats.deallocations_ = num_deallocations_.load(std::memory_order_relaxed);
+  stats.checksum_failures_ = num_checksum_failures_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+bool DiskManager::ReadPage(page_id_t logical_page_id, char *page_data) {
   ASSERT(logical_page_id >= 0, "Invalid page id.");
-  ReadPhysicalPage(MapPageId(logical_page_id), page_data);
+  return ReadPhysicalPage(MapPageId(logical_page_id), page_data);
 }
 
 void DiskManager::WritePage(page_id_t logical_page_id, const char *page_data) {
@@ -46,6 +105,51 @@ void DiskManager::WritePage(page_id_t logical_page_id, const char *page_data) {
   WritePhysicalPage(MapPageId(logical_page_id), page_data);
 }
 
+char *DiskManager::GetMappedPage(page_id_t logical_page_id) {
+  ASSERT(mapping_ != nullptr, "Disk manager is not memory mapped.");
+  ASSERT(logical_page_id >= 0, "Invalid page id.");
+  size_t offset = static_cast<size_t>(MapPageId(logical_page_id)) * PAGE_SIZE;
+  // touching the mapping beyond the end of the file raises SIGBUS, so grow the file in chunks first
+  if (offset + PAGE_SIZE > file_size_.load()) {
+    std::scoped_lock<std::mutex> lock(map_latch_);
+    size_t size = file_size_.load();
+    if (offset + PAGE_SIZE > size) {
+      size_t end = offset + MAPPED_GROW_PAGES * PAGE_SIZE;
+      // posix_fallocate never shrinks the file, unlike ftruncate racing with a concurrent pwrite
+      int ret = posix_fallocate(db_fd_, 0, end);
+      if (ret != 0) {
+        LOG(FATAL) << "I/O error while growing the mapped file: " << strerror(ret);
+      }
+      while (size < end && !file_size_.compare_exchange_weak(size, end)) {
+      }
+    }
+  }
+  return mapping_ + offset;
+}
+
+bool DiskManager::VerifyMappedPage(page_id_t logical_page_id) {
+  page_id_t physical_page_id = MapPageId(logical_page_id);
+  if (!VerifyPageChecksum(mapping_ + static_cast<size_t>(physical_page_id) * PAGE_SIZE, physical_page_id)) {
+    ReportChecksumFailure(physical_page_id);
+    return false;
+  }
+  return true;
+}
+
+void DiskManager::ReleaseMappedPage(page_id_t logical_page_id) {
+  size_t offset = static_cast<size_t>(MapPageId(logical_page_id)) * PAGE_SIZE;
+  if (offset + PAGE_SIZE <= file_size_.load()) {
+    madvise(mapping_ + offset, PAGE_SIZE, MADV_DONTNEED);
+  }
+}
+
+void DiskManager::PrefetchMappedPage(page_id_t logical_page_id) {
+  size_t offset = static_cast<size_t>(MapPageId(logical_page_id)) * PAGE_SIZE;
+  if (offset + PAGE_SIZE <= file_size_.load()) {
+    madvise(mapping_ + offset, PAGE_SIZE, MADV_WILLNEED);
+  }
+}
+
 /**
  * TODO: Student Implement
  */
@@ -53,14 +157,13 @@ page_id_t DiskManager::AllocatePage() {
   uint32_t bitmap_offset;
   uint16_t extent_offset;
   page_id_t logical_page_id;
-  char bitmap_data_[PAGE_SIZE];
-  BitmapPage<PAGE_SIZE>* bitmap_page_;
+  BitmapPage<PAGE_USABLE_SIZE>* bitmap_page_;
   auto meta_page_ = reinterpret_cast<DiskFileMetaPage*>(meta_data_);
+  std::scoped_lock<std::mutex> lock(meta_latch_);
 //  LOG(INFO) << "DiskManager::AllocatePage() called" << std::endl;
-  ReadPhysicalPage(1 + next_free_extent_ * (BITMAP_SIZE + 1), bitmap_data_);
-  bitmap_page_ = reinterpret_cast<BitmapPage<PAGE_SIZE>*>(bitmap_data_);
+  bitmap_page_ = GetBitmap(next_free_extent_);
   if (bitmap_page_->AllocatePage(bitmap_offset)) {
-    std::thread t(&DiskManager::WritePhysicalPage, this, 1 + next_free_extent_ * (BITMAP_SIZE + 1), bitmap_data_);
+    bitmaps_[next_free_extent_]->is_dirty_ = true;
     logical_page_id = bitmap_offset + next_free_extent_ * BITMAP_SIZE;
     extent_offset = next_free_extent_;
     if (meta_page_->extent_used_page_[next_free_extent_] == 0) {
@@ -68,6 +171,7 @@ page_id_t DiskManager::AllocatePage() {
     }
     meta_page_->extent_used_page_[next_free_extent_]++;
     meta_page_->num_allocated_pages_++;
+    StatsAdd(num_allocations_);
     while (meta_page_->extent_used_page_[next_free_extent_] == BITMAP_SIZE) {
       next_free_extent_++;
       next_free_extent_ %= EXTENT_SIZE;
@@ -76,7 +180,6 @@ page_id_t DiskManager::AllocatePage() {
 //              << ", ExtentOffset: " << extent_offset << ", BitmapOffset: " << bitmap_offset
 //              << ", LogicPageID: " << logical_page_id << ", ExtentUsed: " << meta_page_->num_extents_
 //              << ", PageAllocated: " << meta_page_->num_allocated_pages_ << ", NextFreeExtent: " << next_free_extent_ << std::endl;
-    t.join();
     return logical_page_id;
   }
   else {
@@ -85,22 +188,54 @@ page_id_t DiskManager::AllocatePage() {
   }
 }
 
+page_id_t DiskManager::AllocatePages(uint32_t count) {
+  auto meta_page_ = reinterpret_cast<DiskFileMetaPage*>(meta_data_);
+  std::scoped_lock<std::mutex> lock(meta_latch_);
+  if (count == 0 || count > BITMAP_SIZE) {
+    return INVALID_PAGE_ID;
+  }
+  // the used page counters tell which extents may hold the run without looking at their bitmaps
+  for (uint32_t i = 0; i < EXTENT_SIZE; i++) {
+    uint32_t extent_id = (next_free_extent_ + i) % EXTENT_SIZE;
+    if (meta_page_->extent_used_page_[extent_id] + count > BITMAP_SIZE) {
+      continue;
+    }
+    uint32_t bitmap_offset;
+    if (!GetBitmap(extent_id)->AllocatePages(count, bitmap_offset)) {
+      continue;
+    }
+    bitmaps_[extent_id]->is_dirty_ = true;
+    if (meta_page_->extent_used_page_[extent_id] == 0) {
+      meta_page_->num_extents_++;
+    }
+    meta_page_->extent_used_page_[extent_id] += count;
+    meta_page_->num_allocated_pages_ += count;
+    StatsAdd(num_allocations_, count);
+    while (meta_page_->extent_used_page_[next_free_extent_] == BITMAP_SIZE) {
+      next_free_extent_++;
+      next_free_extent_ %= EXTENT_SIZE;
+    }
+    return extent_id * BITMAP_SIZE + bitmap_offset;
+  }
+  return INVALID_PAGE_ID;
+}
+
 /**
  * TODO: Student Implement
  */
 void DiskManager::DeAllocatePage(page_id_t logical_page_id) {
   uint32_t bitmap_offset = logical_page_id % BITMAP_SIZE, extent_offset = logical_page_id / BITMAP_SIZE;
-  char bitmap_data_[PAGE_SIZE];
-  BitmapPage<PAGE_SIZE>* bitmap_page_;
+  BitmapPage<PAGE_USABLE_SIZE>* bitmap_page_;
   auto meta_page_ = reinterpret_cast<DiskFileMetaPage*>(meta_data_);
+  std::scoped_lock<std::mutex> lock(meta_latch_);
 //  LOG(INFO) << "DiskManager::DeAllocatePage() called." << std::endl;
-  ReadPhysicalPage(1 + extent_offset * (BITMAP_SIZE + 1), bitmap_data_);
-  bitmap_page_ = reinterpret_cast<BitmapPage<PAGE_SIZE>*>(bitmap_data_);
+  bitmap_page_ = GetBitmap(extent_offset);
   if (bitmap_page_->DeAllocatePage(bitmap_offset)) {
-    std::thread t(&DiskManager::WritePhysicalPage, this, 1 + extent_offset * (BITMAP_SIZE + 1), bitmap_data_);
+    bitmaps_[extent_offset]->is_dirty_ = true;
     next_free_extent_ = extent_offset;
     meta_page_->extent_used_page_[extent_offset]--;
     meta_page_->num_allocated_pages_--;
+    StatsAdd(num_deallocations_);
     if (meta_page_->extent_used_page_[extent_offset] == 0) {
       meta_page_->num_extents_--;
     }
@@ -108,8 +243,6 @@ void DiskManager::DeAllocatePage(page_id_t logical_page_id) {
 //              << ", ExtentOffset: " << extent_offset << ", BitmapOffset: " << bitmap_offset
 //              << ", LogicPageID: " << logical_page_id << ", ExtentUsed: " << meta_page_->num_extents_
 //              << ", PageAllocated: " << meta_page_->num_allocated_pages_ << ", NextFreeExtent: " << next_free_extent_ << std::endl;
-    WritePhysicalPage(1 + extent_offset * (BITMAP_SIZE + 1), bitmap_data_);
-    t.join();
   }
   else {
 //    LOG(WARNING) << "DiskManager::DeAllocatePage() failed." << std::endl;
@@ -121,12 +254,8 @@ void DiskManager::DeAllocatePage(page_id_t logical_page_id) {
  */
 bool DiskManager::IsPageFree(page_id_t logical_page_id) {
   uint32_t bitmap_offset = logical_page_id % BITMAP_SIZE, extent_offset = logical_page_id / BITMAP_SIZE;
-  char bitmap_data_[PAGE_SIZE];
-  BitmapPage<PAGE_SIZE>* bitmap_page_;
-  DiskFileMetaPage* meta_page_ = reinterpret_cast<DiskFileMetaPage*>(meta_data_);
-  ReadPhysicalPage(1 + extent_offset * (BITMAP_SIZE + 1), bitmap_data_);
-  bitmap_page_ = reinterpret_cast<BitmapPage<PAGE_SIZE>*>(bitmap_data_);
-  return bitmap_page_->IsPageFree(bitmap_offset);
+  std::scoped_lock<std::mutex> lock(meta_latch_);
+  return GetBitmap(extent_offset)->IsPageFree(bitmap_offset);
 }
 
 /**
@@ -137,45 +266,93 @@ page_id_t DiskManager::MapPageId(page_id_t logical_page_id) {
   return 1 + extent_offset * (BITMAP_SIZE + 1) + bitmap_offset + 1;
 }
 
-int DiskManager::GetFileSize(const std::string &file_name) {
-  struct stat stat_buf;
-  int rc = stat(file_name.c_str(), &stat_buf);
-  return rc == 0 ? stat_buf.st_size : -1;
+BitmapPage<PAGE_USABLE_SIZE> *DiskManager::GetBitmap(uint32_t extent_id) {
+  auto &frame = bitmaps_[extent_id];
+  if (frame == nullptr) {
+    frame = std::make_unique<BitmapFrame>();
+    ReadPhysicalPage(1 + extent_id * (BITMAP_SIZE + 1), frame->data_);
+  }
+  return reinterpret_cast<BitmapPage<PAGE_USABLE_SIZE> *>(frame->data_);
 }
 
-void DiskManager::ReadPhysicalPage(page_id_t physical_page_id, char *page_data) {
-  int offset = physical_page_id * PAGE_SIZE;
+void DiskManager::FlushBitmaps() {
+  for (uint32_t extent_id = 0; extent_id < bitmaps_.size(); extent_id++) {
+    auto &frame = bitmaps_[extent_id];
+    if (frame != nullptr && frame->is_dirty_) {
+      WritePhysicalPage(1 + extent_id * (BITMAP_SIZE + 1), frame->data_);
+      frame->is_dirty_ = false;
+    }
+  }
+}
+
+bool DiskManager::ReadPhysicalPage(page_id_t physical_page_id, char *page_data) {
+  StatsAdd(num_reads_);
+  size_t offset = static_cast<size_t>(physical_page_id) * PAGE_SIZE;
   // check if read beyond file length
-  if (offset >= GetFileSize(file_name_)) {
+  if (offset >= file_size_.load()) {
 #ifdef ENABLE_BPM_DEBUG
     LOG(INFO) << "Read less than a page" << std::endl;
 #endif
     memset(page_data, 0, PAGE_SIZE);
-  } else {
-    // set read cursor to offset
-    db_io_.seekp(offset);
-    db_io_.read(page_data, PAGE_SIZE);
-    // if file ends before reading PAGE_SIZE
-    int read_count = db_io_.gcount();
-    if (read_count < PAGE_SIZE) {
+    return true;
+  }
+  size_t read_count = 0;
+  while (read_count < PAGE_SIZE) {
+    ssize_t ret = pread(db_fd_, page_data + read_count, PAGE_SIZE - read_count, offset + read_count);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      if (ret < 0) {
+        LOG(ERROR) << "I/O error while reading: " << strerror(errno);
+      }
+      break;
+    }
+    read_count += ret;
+  }
+  // if file ends before reading PAGE_SIZE
+  if (read_count < PAGE_SIZE) {
 #ifdef ENABLE_BPM_DEBUG
-      LOG(INFO) << "Read less than a page" << std::endl;
+    LOG(INFO) << "Read less than a page" << std::endl;
 #endif
-      memset(page_data + read_count, 0, PAGE_SIZE - read_count);
-    }
+    memset(page_data + read_count, 0, PAGE_SIZE - read_count);
   }
+  if (!VerifyPageChecksum(page_data, physical_page_id)) {
+    ReportChecksumFailure(physical_page_id);
+    return false;
+  }
+  return true;
+}
+
+void DiskManager::ReportChecksumFailure(page_id_t physical_page_id) {
+  StatsAdd(num_checksum_failures_);
+  LOG(ERROR) << "Checksum mismatch on physical page " << physical_page_id << " of " << file_name_;
 }
 
 void DiskManager::WritePhysicalPage(page_id_t physical_page_id, const char *page_data) {
   size_t offset = static_cast<size_t>(physical_page_id) * PAGE_SIZE;
-  // set write cursor to offset
-  db_io_.seekp(offset);
-  db_io_.write(page_data, PAGE_SIZE);
-  // check for I/O error
-  if (db_io_.bad()) {
-    LOG(ERROR) << "I/O error while writing";
-    return;
+  StatsAdd(num_writes_);
+  // stamp a copy, the caller's page may still be modified by others while it is written
+  char stamped[PAGE_SIZE];
+  memcpy(stamped, page_data, PAGE_USABLE_SIZE);
+  StampPageChecksum(stamped, physical_page_id);
+  size_t write_count = 0;
+  while (write_count < PAGE_SIZE) {
+    ssize_t ret = pwrite(db_fd_, stamped + write_count, PAGE_SIZE - write_count, offset + write_count);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    // check for I/O error
+    if (ret < 0) {
+      LOG(ERROR) << "I/O error while writing: " << strerror(errno);
+      return;
+    }
+    write_count += ret;
   }
-  // needs to flush to keep disk file in sync
-  db_io_.flush();
-}
\ No newline at end of file
+  needs_sync_ = true;
+  // grow the cached file size, writers of different pages may race here
+  size_t end = offset + PAGE_SIZE;
+  size_t size = file_size_.load();
+  while (size < end && !file_size_.compare_exchange_weak(size, end)) {
+  }
+}
@@ -0,0 +1,77 @@
+#include "storage/disk_scheduler.h"
+
+#include "glog/logging.h"
+
+DiskScheduler::DiskScheduler(DiskManager *disk_manager, size_t num_workers) : disk_manager_(disk_manager) {
+  ASSERT(num_workers > 0, "Disk scheduler needs at least one worker.");
+  for (size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back(&DiskScheduler::WorkerLoop, this);
+  }
+}
+
+DiskScheduler::~DiskScheduler() {
+  {
+    std::scoped_lock<std::mutex> lock(queue_latch_);
+    shutdown_ = true;
+  }
+  queue_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void DiskScheduler::Schedule(DiskRequest request) {
+  {
+    std::scoped_lock<std::mutex> lock(queue_latch_);
+    ASSERT(!shutdown_, "Request scheduled after shutdown.");
+    queue_.emplace_back(std::move(request));
+  }
+  queue_cv_.notify_one();
+}
+
+std::future<bool> DiskScheduler::ScheduleRead(page_id_t page_id, char *data, std::function<void(bool)> callback) {
+  DiskRequest request;
+  request.is_write_ = false;
+  request.page_id_ = page_id;
+  request.data_ = data;
+  request.callback_ = std::move(callback);
+  auto future = request.promise_.get_future();
+  Schedule(std::move(request));
+  return future;
+}
+
+std::future<bool> DiskScheduler::ScheduleWrite(page_id_t page_id, char *data, std::function<void(bool)> callback) {
+  DiskRequest request;
+  request.is_write_ = true;
+  request.page_id_ = page_id;
+  request.data_ = data;
+  request.callback_ = std::move(callback);
+  auto future = request.promise_.get_future();
+  Schedule(std::move(request));
+  return future;
+}
+
+void DiskScheduler::WorkerLoop() {
+  while (true) {
+    DiskRequest request;
+    {
+      std::unique_lock<std::mutex> lock(queue_latch_);
+      queue_cv_.wait(lock, [this] { return shutdown_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      request = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    bool success = true;
+    if (request.is_write_) {
+      disk_manager_->WritePage(request.page_id_, request.data_);
+    } else {
+      success = disk_manager_->ReadPage(request.page_id_, request.data_);
+    }
+    if (request.callback_) {
+      request.callback_(success);
+    }
+    request.promise_.set_value(success);
+  }
+}
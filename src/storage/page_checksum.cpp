@@ -0,0 +1,88 @@
+#include "storage/page_checksum.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "common/crc32c.h"
+
+uint32_t ComputePageChecksum(const char *page_data, page_id_t physical_page_id) {
+  uint32_t crc = Crc32c(page_data, PAGE_USABLE_SIZE);
+  return Crc32c(reinterpret_cast<const char *>(&physical_page_id), sizeof(physical_page_id), crc);
+}
+
+void StampPageChecksum(char *page_data, page_id_t physical_page_id) {
+  uint32_t checksum = ComputePageChecksum(page_data, physical_page_id);
+  memcpy(page_data + PAGE_USABLE_SIZE, &checksum, sizeof(checksum));
+}
+
+bool VerifyPageChecksum(const char *page_data, page_id_t physical_page_id) {
+  uint32_t checksum;
+  memcpy(&checksum, page_data + PAGE_USABLE_SIZE, sizeof(checksum));
+  if (checksum == ComputePageChecksum(page_data, physical_page_id)) {
+    return true;
+  }
+  // a page which was never written
+  return checksum == 0 && std::all_of(page_data, page_data + PAGE_USABLE_SIZE, [](char c) { return c == 0; });
+}
+
+ChecksumReport VerifyFileChecksums(const std::string &db_file, size_t num_threads) {
+  static constexpr size_t BATCH_PAGES = 64;
+  ChecksumReport report;
+  int fd = open(db_file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return report;
+  }
+  struct stat stat_buf;
+  if (fstat(fd, &stat_buf) != 0) {
+    close(fd);
+    return report;
+  }
+  report.opened_ = true;
+  report.pages_checked_ = stat_buf.st_size / PAGE_SIZE;
+  num_threads = std::max<size_t>(1, std::min(num_threads, report.pages_checked_));
+  size_t pages_per_thread = (report.pages_checked_ + num_threads - 1) / num_threads;
+  std::vector<std::vector<page_id_t>> corrupt_pages(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      size_t begin = t * pages_per_thread;
+      size_t end = std::min(report.pages_checked_, begin + pages_per_thread);
+      std::unique_ptr<char[]> buffer(new char[BATCH_PAGES * PAGE_SIZE]);
+      for (size_t first = begin; first < end; first += BATCH_PAGES) {
+        size_t count = std::min(BATCH_PAGES, end - first);
+        size_t length = count * PAGE_SIZE;
+        size_t read_count = 0;
+        while (read_count < length) {
+          ssize_t ret = pread(fd, buffer.get() + read_count, length - read_count, first * PAGE_SIZE + read_count);
+          if (ret < 0 && errno == EINTR) {
+            continue;
+          }
+          if (ret <= 0) {
+            break;
+          }
+          read_count += ret;
+        }
+        for (size_t i = 0; i < count; i++) {
+          auto page_id = static_cast<page_id_t>(first + i);
+          if ((i + 1) * PAGE_SIZE > read_count || !VerifyPageChecksum(buffer.get() + i * PAGE_SIZE, page_id)) {
+            corrupt_pages[t].push_back(page_id);
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  close(fd);
+  // the ranges are ascending, so are the pages found in them
+  for (auto &pages : corrupt_pages) {
+    report.corrupt_pages_.insert(report.corrupt_pages_.end(), pages.begin(), pages.end());
+  }
+  return report;
+}
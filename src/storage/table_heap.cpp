@@ -1,96 +1,110 @@
 #include "storage/table_heap.h"
 
+#include <algorithm>
+#include <string>
+
 /**
  * TODO: Student Implement
  */
-bool TableHeap::InsertTuple(Row &row, Transaction *txn){
-  if(total_page > 5)
-  {
-    auto last_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(last_page_id));
-    if(last_page == nullptr)
-    {
-      buffer_pool_manager_->UnpinPage(last_page_id, false);
+bool TableHeap::InsertTuple(Row &row, Transaction *txn) {
+  StatsScope scope(&access_stats_);
+  Row spilled;
+  Row *stored = SpillLongValues(row, spilled);
+  if (stored == nullptr) {
+    return false;
+  }
+  if (stored != &row) {
+    // the copy refers to overflow pages for its long values, it is stored in place of the row
+    bool inserted = InsertTuple(*stored, txn);
+    if (!inserted) {
+      FreeOverflow(*stored);
+    }
+    row.SetRowId(stored->GetRowId());
+    return inserted;
+  }
+  if (!RowFits(row)) {
+    return false;
+  }
+  LoadFreeSpaceMap();
+  // an entry may be stale, it is corrected by the failed attempt and the next best page is tried
+  while (true) {
+    page_id_t page_id = FindPageWithFreeSpace(GetSpaceNeeded(row));
+    bool appended = page_id == INVALID_PAGE_ID;
+    auto page = appended ? AppendPage(page_id, txn) : buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
       return false;
     }
-    if(last_page->InsertTuple(row, schema_, txn, lock_manager_, log_manager_)){
-      buffer_pool_manager_->UnpinPage(last_page_id, true);
-    }else{
-      page_id_t next_page_id;
-      auto new_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(next_page_id));
-      if(new_page != nullptr && next_page_id != INVALID_PAGE_ID)
-      {
-        new_page->Init(next_page_id, last_page_id, log_manager_, txn);
-        last_page->SetNextPageId(next_page_id);
-        new_page->InsertTuple(row, schema_, txn, lock_manager_, log_manager_);
-        buffer_pool_manager_->UnpinPage(last_page_id, false);
-        buffer_pool_manager_->UnpinPage(next_page_id, true);
-        last_page_id = next_page_id;
-        total_page++;
-      }
-      else
-      {
-        buffer_pool_manager_->UnpinPage(next_page_id, true);
-        buffer_pool_manager_->UnpinPage(last_page_id, false);
-        return false;
-      }
+    bool inserted =
+        VisitPage(page, [&](auto p) { return p->InsertTuple(row, schema_, txn, lock_manager_, log_manager_); });
+    RecordFreeSpace(page_id, GetFreeSpace(page));
+    buffer_pool_manager_->UnpinPage(page_id, appended || inserted);
+    if (inserted) {
+      return true;
     }
-    return true;
   }
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(GetFirstPageId()));
-  bool is_not_valid = buffer_pool_manager_->IsPageFree(GetFirstPageId());
-  if(is_not_valid) {
-    page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(first_page_id_));
-  }
-  if(page == nullptr)
-  {
-    buffer_pool_manager_->UnpinPage(first_page_id_, false);
-    return false;
+}
+
+dberr_t TableHeap::InsertTuples(std::vector<Row> &rows, Transaction *txn) {
+  StatsScope scope(&access_stats_);
+  // the rows with long values are stored through copies referring to overflow pages
+  std::vector<Row> spilled(has_long_columns_ ? rows.size() : 0);
+  std::vector<Row *> stored;
+  stored.reserve(rows.size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    Row *row = has_long_columns_ ? SpillLongValues(rows[i], spilled[i]) : &rows[i];
+    if (row == nullptr || !RowFits(*row)) {
+      for (auto &spilled_row : spilled) {
+        FreeOverflow(spilled_row);
+      }
+      return row == nullptr ? DB_BUFFER_POOL_FULL : DB_FAILED;
+    }
+    stored.push_back(row);
   }
-  page_id_t page_id = GetFirstPageId();
-  while(1)
-  {
-    if(page->InsertTuple(row, schema_, txn, lock_manager_, log_manager_))
-    {
-      return buffer_pool_manager_->UnpinPage(page_id, true);
-    }
-    auto next_page_id = page->GetNextPageId();
-    if(next_page_id == INVALID_PAGE_ID)
-    {
-      auto new_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(next_page_id));
-      if(new_page == nullptr || next_page_id == INVALID_PAGE_ID)
-      {
-        buffer_pool_manager_->UnpinPage(page_id, false);
-        return false;
+  LoadFreeSpaceMap();
+  size_t next = 0;
+  while (next < rows.size()) {
+    page_id_t page_id = FindPageWithFreeSpace(GetSpaceNeeded(*stored[next]));
+    bool appended = page_id == INVALID_PAGE_ID;
+    auto page = appended ? AppendPage(page_id, txn) : buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      // the batch is all or nothing: the rows already stored are taken out again, with their overflow pages
+      for (size_t i = 0; i < next; i++) {
+        ApplyDelete(stored[i]->GetRowId(), txn);
       }
-      else{
-        new_page->Init(next_page_id, page_id, log_manager_, txn);
-        page->SetNextPageId(next_page_id);
-        buffer_pool_manager_->UnpinPage(page_id, false);
-        page = new_page;
-        page_id = next_page_id;
+      for (size_t i = next; i < spilled.size(); i++) {
+        FreeOverflow(spilled[i]);
       }
+      return DB_BUFFER_POOL_FULL;
     }
-    else{
-      buffer_pool_manager_->UnpinPage(page_id, false);
-      page_id = next_page_id;
-      page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
-    }
+    // fill the pinned page as far as it goes, a new page always takes at least one row
+    size_t first = next;
+    VisitPage(page, [&](auto p) {
+      while (next < rows.size() && p->InsertTuple(*stored[next], schema_, txn, lock_manager_, log_manager_)) {
+        next++;
+      }
+    });
+    RecordFreeSpace(page_id, GetFreeSpace(page));
+    buffer_pool_manager_->UnpinPage(page_id, appended || next > first);
   }
-  return false;
+  for (size_t i = 0; i < rows.size(); i++) {
+    rows[i].SetRowId(stored[i]->GetRowId());
+  }
+  return DB_SUCCESS;
 }
 
 bool TableHeap::MarkDelete(const RowId &rid, Transaction *txn) {
+  StatsScope scope(&access_stats_);
   // Find the page which contains the tuple.
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  auto page = buffer_pool_manager_->FetchPage(rid.GetPageId());
   // If the page could not be found, then abort the transaction.
   if (page == nullptr) {
     return false;
   }
   // Otherwise, mark the tuple as deleted.
   page->WLatch();
-  page->MarkDelete(rid, txn, lock_manager_, log_manager_);
+  VisitPage(page, [&](auto p) { return p->MarkDelete(rid, txn, lock_manager_, log_manager_); });
   page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
   return true;
 }
 
@@ -98,29 +112,55 @@ bool TableHeap::MarkDelete(const RowId &rid, Transaction *txn) {
  * TODO: Student Implement
  */
 bool TableHeap::UpdateTuple(Row &row, const RowId &rid, Transaction *txn) {
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  StatsScope scope(&access_stats_);
+  // a row a pax page cannot hold in place could not be inserted elsewhere either
+  if (layout_ == TableLayout::kPax && !RowFits(row)) {
+    return false;
+  }
+  auto page = buffer_pool_manager_->FetchPage(rid.GetPageId());
   auto page_id = rid.GetPageId();
   if(page == nullptr)
   {
     buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
     return false;
   }
+  // the tuple keeps its rid when it is updated in place
+  row.SetRowId(rid);
+  Row spilled;
+  Row *stored = SpillLongValues(row, spilled);
+  if (stored == nullptr) {
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    return false;
+  }
   Row old_row;
   old_row.SetRowId(rid);
-  int msg = page->UpdateTuple(row, &old_row, schema_, txn, lock_manager_, log_manager_);
+  int msg = VisitPage(page, [&](auto p) {
+    return p->UpdateTuple(*stored, &old_row, schema_, txn, lock_manager_, log_manager_);
+  });
   if(msg == 1)
   {
+    // the long values of the old tuple are not referred to any more
+    FreeOverflow(old_row);
+    LoadFreeSpaceMap();
+    RecordFreeSpace(page_id, GetFreeSpace(page));
     buffer_pool_manager_->UnpinPage(page_id, true);
     return true;
   }
   else if(msg == -3)
   {
     ApplyDelete(rid, txn);
-    InsertTuple(row, txn);
+    bool inserted = InsertTuple(*stored, txn);
     buffer_pool_manager_->UnpinPage(page_id, true);
+    if (!inserted) {
+      FreeOverflow(spilled);
+      return false;
+    }
+    row.SetRowId(stored->GetRowId());
     //Log(INFO) << "Table_Heap::UpdateTuple() succeed: " << "page_id: " << page_id;
     return true;
   }
+  FreeOverflow(spilled);
+  buffer_pool_manager_->UnpinPage(page_id, false);
   return false;
 }
 
@@ -128,15 +168,27 @@ bool TableHeap::UpdateTuple(Row &row, const RowId &rid, Transaction *txn) {
  * TODO: Student Implement
  */
 void TableHeap::ApplyDelete(const RowId &rid, Transaction *txn) {
+  StatsScope scope(&access_stats_);
   auto page_id = rid.GetPageId();
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  auto page = buffer_pool_manager_->FetchPage(page_id);
   if(page == nullptr)
   {
     buffer_pool_manager_->UnpinPage(first_page_id_, false);
     return;
   }
   else {
-    page->ApplyDelete(rid, txn, log_manager_);
+    if (has_long_columns_) {
+      uint32_t tuple_size;
+      char *data = reinterpret_cast<TablePage *>(page)->GetTupleData(rid.GetSlotNum(), &tuple_size, true);
+      if (data != nullptr) {
+        Row old_row;
+        old_row.DeserializeFrom(data, schema_);
+        FreeOverflow(old_row);
+      }
+    }
+    VisitPage(page, [&](auto p) { p->ApplyDelete(rid, txn, log_manager_); });
+    LoadFreeSpaceMap();
+    RecordFreeSpace(page_id, GetFreeSpace(page));
     buffer_pool_manager_->UnpinPage(page_id, true);
   }
   // Step1: Find the page which contains the tuple.
@@ -144,30 +196,33 @@ void TableHeap::ApplyDelete(const RowId &rid, Transaction *txn) {
 }
 
 void TableHeap::RollbackDelete(const RowId &rid, Transaction *txn) {
+  StatsScope scope(&access_stats_);
   // Find the page which contains the tuple.
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  auto page = buffer_pool_manager_->FetchPage(rid.GetPageId());
   assert(page != nullptr);
   // Rollback to delete.
   page->WLatch();
-  page->RollbackDelete(rid, txn, log_manager_);
+  VisitPage(page, [&](auto p) { p->RollbackDelete(rid, txn, log_manager_); });
   page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
 }
 
 /**
  * TODO: Student Implement
  */
 bool TableHeap::GetTuple(Row *row, Transaction *txn) {
+  StatsScope scope(&access_stats_);
   RowId rowid = row->GetRowId();
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rowid.GetPageId()));
+  auto page = buffer_pool_manager_->FetchPage(rowid.GetPageId());
   auto page_id = rowid.GetPageId();
   if(page == nullptr){
     buffer_pool_manager_->UnpinPage(page_id, false);
     return false;
   }
-  if(page->GetTuple(row, schema_, txn, lock_manager_))
+  if(VisitPage(page, [&](auto p) { return p->GetTuple(row, schema_, txn, lock_manager_); }))
   {
     buffer_pool_manager_->UnpinPage(page_id, false);
+    ReadOverflow(row);
     return true;
   }
   buffer_pool_manager_->UnpinPage(page_id, false);
@@ -175,43 +230,67 @@ bool TableHeap::GetTuple(Row *row, Transaction *txn) {
 }
 
 void TableHeap::DeleteTable(page_id_t page_id) {
-  if (page_id != INVALID_PAGE_ID) {
-    auto temp_table_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));  // 删除table_heap
-    if (temp_table_page->GetNextPageId() != INVALID_PAGE_ID)
-      DeleteTable(temp_table_page->GetNextPageId());
-    buffer_pool_manager_->UnpinPage(page_id, false);
-    buffer_pool_manager_->DeletePage(page_id);
-  } else {
-    DeleteTable(first_page_id_);
+  StatsScope scope(&access_stats_);
+  BufferAccessStrategy strategy;
+  bool whole_table = page_id == INVALID_PAGE_ID;
+  if (!whole_table) {
+    LoadFreeSpaceMap();
+  }
+  page_id_t next_page_id = whole_table ? first_page_id_ : page_id;
+  while (next_page_id != INVALID_PAGE_ID) {
+    auto old_page_id = next_page_id;
+    auto temp_table_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(old_page_id, &strategy));  // 删除table_heap
+    next_page_id = temp_table_page->GetNextPageId();
+    if (!whole_table && old_page_id == page_id) {
+      last_page_id_ = temp_table_page->GetPrevPageId();
+    }
+    if (has_long_columns_) {
+      FreePageOverflow(temp_table_page);
+    }
+    buffer_pool_manager_->UnpinPage(old_page_id, false);
+    buffer_pool_manager_->FreePage(old_page_id);
+    if (!whole_table) {
+      ForgetFreeSpace(old_page_id);
+    }
+  }
+  if (!whole_table && last_page_id_ != INVALID_PAGE_ID) {
+    // the page before the freed ones ends the chain now
+    auto last_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(last_page_id_));
+    last_page->SetNextPageId(INVALID_PAGE_ID);
+    buffer_pool_manager_->UnpinPage(last_page_id_, true);
   }
+  if (whole_table) {
+    page_id_t fsm_page_id = fsm_page_id_;
+    while (fsm_page_id != INVALID_PAGE_ID) {
+      auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(fsm_page_id)->GetData());
+      page_id_t next_fsm_page_id = fsm_page->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(fsm_page_id, false);
+      buffer_pool_manager_->FreePage(fsm_page_id);
+      fsm_page_id = next_fsm_page_id;
+    }
+    fsm_entries_.clear();
+    fsm_by_category_.clear();
+  }
+  buffer_pool_manager_->ReleaseReservation(&reservation_);
 }
 
 /**
  * TODO: Student Implement
  */
-TableIterator TableHeap::Begin(Transaction *txn) {
+TableIterator TableHeap::Begin(Transaction *txn, BufferAccessStrategy *strategy) {
+  StatsScope scope(&access_stats_);
   page_id_t page_id = first_page_id_;
-  RowId result_rid;
-  while(1)
-  {
-    if(page_id == INVALID_PAGE_ID)
-    {
-      return End();
-    }
-    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
-    if(page->GetFirstTupleRid(&result_rid))
-    {
-      buffer_pool_manager_->UnpinPage(page_id, false);
-      break;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id, strategy));
+    buffer_pool_manager_->ReadAhead(page_id, page->GetNextPageId(), strategy);
+    RowId first_rid;
+    if (VisitPage(page, [&](auto p) { return p->GetFirstTupleRid(&first_rid); })) {
+      // the iterator keeps the page pinned
+      return TableIterator(this, page, first_rid, strategy);
     }
+    page_id_t next_page_id = page->GetNextPageId();
     buffer_pool_manager_->UnpinPage(page_id, false);
-    page_id = page->GetNextPageId();
-  }
-  if(page_id != INVALID_PAGE_ID)
-  {
-    Row* result_row = new Row(result_rid);
-    GetTuple(result_row, txn);
-    return TableIterator(result_row, this, result_rid);
+    page_id = next_page_id;
   }
   return End();
 }
@@ -219,7 +298,255 @@ TableIterator TableHeap::Begin(Transaction *txn) {
 /**
  * TODO: Student Implement
  */
-TableIterator TableHeap::End() {
-  RowId null;
-  return TableIterator(nullptr, this, null);
+TableIterator TableHeap::End() { return TableIterator(this, nullptr, RowId()); }
+
+Page *TableHeap::AppendPage(page_id_t &page_id, Transaction *txn) {
+  auto new_page = buffer_pool_manager_->NewPage(page_id, &reservation_);
+  if (new_page == nullptr) {
+    return nullptr;
+  }
+  auto last_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(last_page_id_));
+  if (last_page == nullptr) {
+    // the page goes back to the reservation for the next append, or else to the disk manager
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+    if (!reservation_.PutBack(page_id)) {
+      buffer_pool_manager_->FreePage(page_id);
+    }
+    return nullptr;
+  }
+  InitPage(new_page, page_id, last_page_id_, txn);
+  last_page->SetNextPageId(page_id);
+  buffer_pool_manager_->UnpinPage(last_page_id_, true);
+  last_page_id_ = page_id;
+  return new_page;
+}
+
+void TableHeap::InitPage(Page *page, page_id_t page_id, page_id_t prev_id, Transaction *txn) {
+  if (layout_ == TableLayout::kPax) {
+    reinterpret_cast<PaxPage *>(page)->Init(page_id, prev_id, schema_, log_manager_, txn);
+  } else {
+    reinterpret_cast<TablePage *>(page)->Init(page_id, prev_id, log_manager_, txn);
+  }
+}
+
+bool TableHeap::RowFits(const Row &row) {
+  if (layout_ == TableLayout::kPax) {
+    return PaxPage::RowFits(row, schema_);
+  }
+  return row.GetSerializedSize(schema_) <= TablePage::SIZE_MAX_ROW;
+}
+
+uint32_t TableHeap::GetFreeSpace(Page *page) {
+  if (layout_ == TableLayout::kPax) {
+    return reinterpret_cast<PaxPage *>(page)->GetFreeSlotCount() * FreeSpaceMapPage::CATEGORY_SIZE;
+  }
+  return reinterpret_cast<TablePage *>(page)->GetFreeSpaceRemaining();
+}
+
+uint32_t TableHeap::GetSpaceNeeded(const Row &row) {
+  if (layout_ == TableLayout::kPax) {
+    return FreeSpaceMapPage::CATEGORY_SIZE;
+  }
+  return row.GetSerializedSize(schema_) + TablePage::SIZE_TUPLE;
+}
+
+bool TableHeap::HasLongColumns(const Schema *schema, TableLayout layout) {
+  if (layout != TableLayout::kRow) {
+    return false;
+  }
+  for (auto column : schema->GetColumns()) {
+    if (column->GetType() == TypeId::kTypeChar && column->GetLength() > CHAR_OVERFLOW_THRESHOLD) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Row *TableHeap::SpillLongValues(Row &row, Row &spilled) {
+  if (!has_long_columns_) {
+    return &row;
+  }
+  auto is_long = [](const Field *field) {
+    return field->GetTypeId() == TypeId::kTypeChar && !field->IsNull() && !field->IsOverflow() &&
+           field->GetLength() > CHAR_OVERFLOW_THRESHOLD;
+  };
+  auto &fields = row.GetFields();
+  if (std::none_of(fields.begin(), fields.end(), is_long)) {
+    return &row;
+  }
+  spilled.destroy();
+  spilled.SetRowId(row.GetRowId());
+  for (auto field : fields) {
+    if (!is_long(field)) {
+      spilled.GetFields().push_back(new Field(*field));
+      continue;
+    }
+    page_id_t overflow_page_id = WriteOverflow(field->GetData(), field->GetLength());
+    if (overflow_page_id == INVALID_PAGE_ID) {
+      FreeOverflow(spilled);
+      spilled.destroy();
+      return nullptr;
+    }
+    spilled.GetFields().push_back(new Field(TypeId::kTypeChar, field->GetLength(), overflow_page_id));
+  }
+  return &spilled;
+}
+
+page_id_t TableHeap::WriteOverflow(const char *data, uint32_t len) {
+  // the pieces are written from the last one, so that each page is linked to the next when it is written
+  page_id_t next_page_id = INVALID_PAGE_ID;
+  uint32_t piece_count = (len + OverflowPage::MAX_DATA_SIZE - 1) / OverflowPage::MAX_DATA_SIZE;
+  for (uint32_t i = piece_count; i-- > 0;) {
+    page_id_t page_id;
+    auto page = buffer_pool_manager_->NewPage(page_id);
+    if (page == nullptr) {
+      FreeOverflowChain(next_page_id);
+      return INVALID_PAGE_ID;
+    }
+    uint32_t offset = i * OverflowPage::MAX_DATA_SIZE;
+    uint32_t size = std::min(len - offset, OverflowPage::MAX_DATA_SIZE);
+    reinterpret_cast<OverflowPage *>(page->GetData())->Init(next_page_id, data + offset, size);
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    next_page_id = page_id;
+  }
+  return next_page_id;
+}
+
+void TableHeap::ReadOverflow(Row *row) {
+  if (!has_long_columns_) {
+    return;
+  }
+  auto &fields = row->GetFields();
+  for (uint32_t i = 0; i < fields.size(); i++) {
+    if (!fields[i]->IsOverflow()) {
+      continue;
+    }
+    std::string data;
+    data.reserve(fields[i]->GetLength());
+    page_id_t page_id = fields[i]->GetOverflowPageId();
+    while (page_id != INVALID_PAGE_ID) {
+      auto page = reinterpret_cast<OverflowPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+      data.append(page->GetData(), page->GetSize());
+      page_id_t next_page_id = page->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      page_id = next_page_id;
+    }
+    ASSERT(data.size() == fields[i]->GetLength(), "Overflow chain does not match the length of its value.");
+    Field value(TypeId::kTypeChar, const_cast<char *>(data.data()), data.size(), false);
+    row->SetField(i, value);
+  }
+}
+
+void TableHeap::FreeOverflow(const Row &row) {
+  for (uint32_t i = 0; i < row.GetFieldCount(); i++) {
+    if (row.GetField(i)->IsOverflow()) {
+      FreeOverflowChain(row.GetField(i)->GetOverflowPageId());
+    }
+  }
+}
+
+void TableHeap::FreeOverflowChain(page_id_t page_id) {
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<OverflowPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    page_id_t next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->FreePage(page_id);
+    page_id = next_page_id;
+  }
+}
+
+void TableHeap::FreePageOverflow(TablePage *page) {
+  RowId rid;
+  bool found = page->GetFirstTupleRid(&rid);
+  while (found) {
+    uint32_t tuple_size;
+    Row row;
+    row.DeserializeFrom(page->GetTupleData(rid.GetSlotNum(), &tuple_size), schema_);
+    FreeOverflow(row);
+    RowId next_rid;
+    found = page->GetNextTupleRid(rid, &next_rid);
+    rid = next_rid;
+  }
+}
+
+void TableHeap::LoadFreeSpaceMap() {
+  if (fsm_loaded_) {
+    return;
+  }
+  ASSERT(fsm_page_id_ != INVALID_PAGE_ID, "Table heap has no free space map.");
+  fsm_loaded_ = true;
+  last_page_id_ = first_page_id_;
+  page_id_t fsm_page_id = fsm_page_id_;
+  while (fsm_page_id != INVALID_PAGE_ID) {
+    auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(fsm_page_id)->GetData());
+    for (uint32_t slot = 0; slot < fsm_page->GetEntryCount(); slot++) {
+      page_id_t page_id = fsm_page->GetPageId(slot);
+      if (page_id == INVALID_PAGE_ID) {
+        continue;
+      }
+      uint8_t category = fsm_page->GetCategory(slot);
+      fsm_entries_[page_id] = {fsm_page_id, slot, category};
+      fsm_by_category_.emplace(category, page_id);
+      last_page_id_ = page_id;
+    }
+    fsm_last_page_id_ = fsm_page_id;
+    fsm_page_id = fsm_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(fsm_last_page_id_, false);
+  }
+}
+
+page_id_t TableHeap::FindPageWithFreeSpace(uint32_t bytes) {
+  uint32_t category = FreeSpaceMapPage::CategoryFor(bytes);
+  if (category > FreeSpaceMapPage::MAX_CATEGORY) {
+    return INVALID_PAGE_ID;
+  }
+  auto iter = fsm_by_category_.lower_bound({category, 0});
+  return iter == fsm_by_category_.end() ? INVALID_PAGE_ID : iter->second;
+}
+
+void TableHeap::RecordFreeSpace(page_id_t page_id, uint32_t free_bytes) {
+  uint8_t category = FreeSpaceMapPage::ToCategory(free_bytes);
+  auto iter = fsm_entries_.find(page_id);
+  if (iter != fsm_entries_.end()) {
+    auto &entry = iter->second;
+    if (entry.category_ == category) {
+      return;
+    }
+    fsm_by_category_.erase({entry.category_, page_id});
+    fsm_by_category_.emplace(category, page_id);
+    entry.category_ = category;
+    auto fsm_page =
+        reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(entry.map_page_id_)->GetData());
+    fsm_page->SetCategory(entry.slot_, category);
+    buffer_pool_manager_->UnpinPage(entry.map_page_id_, true);
+    return;
+  }
+  auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(fsm_last_page_id_)->GetData());
+  if (fsm_page->IsFull()) {
+    page_id_t new_fsm_page_id;
+    auto new_fsm_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->NewPage(new_fsm_page_id)->GetData());
+    new_fsm_page->Init();
+    fsm_page->SetNextPageId(new_fsm_page_id);
+    buffer_pool_manager_->UnpinPage(fsm_last_page_id_, true);
+    fsm_last_page_id_ = new_fsm_page_id;
+    fsm_page = new_fsm_page;
+  }
+  uint32_t slot = fsm_page->Append(page_id, category);
+  buffer_pool_manager_->UnpinPage(fsm_last_page_id_, true);
+  fsm_entries_[page_id] = {fsm_last_page_id_, slot, category};
+  fsm_by_category_.emplace(category, page_id);
+}
+
+void TableHeap::ForgetFreeSpace(page_id_t page_id) {
+  auto iter = fsm_entries_.find(page_id);
+  if (iter == fsm_entries_.end()) {
+    return;
+  }
+  auto &entry = iter->second;
+  auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(entry.map_page_id_)->GetData());
+  fsm_page->Remove(entry.slot_);
+  buffer_pool_manager_->UnpinPage(entry.map_page_id_, true);
+  fsm_by_category_.erase({entry.category_, page_id});
+  fsm_entries_.erase(iter);
 }
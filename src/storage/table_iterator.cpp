@@ -3,84 +3,131 @@
 #include "common/macros.h"
 #include "storage/table_heap.h"
 
-/**
- * TODO: Student Implement
- */
-TableIterator::TableIterator() {
-
+void RowView::Materialize(Row *row, Schema *schema, const std::vector<uint32_t> *columns) const {
+  if (pax_page_ != nullptr) {
+    row->SetRowId(rid_);
+    if (columns != nullptr) {
+      pax_page_->ReadColumns(rid_.GetSlotNum(), schema, *columns, row);
+    } else {
+      pax_page_->GetTuple(row, schema, nullptr, nullptr);
+    }
+    return;
+  }
+  row->destroy();
+  uint32_t __attribute__((unused)) read_bytes =
+      columns != nullptr ? row->DeserializeFrom(data_, schema, *columns) : row->DeserializeFrom(data_, schema);
+  ASSERT(size_ == read_bytes, "Unexpected behavior in tuple deserialize.");
+  row->SetRowId(rid_);
+  if (heap_ != nullptr) {
+    heap_->ReadOverflow(row);
+  }
 }
 
-TableIterator::TableIterator(const TableIterator &other) {
-  RowId rowid(-1,0);
-  if (other.row_){
-    row_ = new Row(*other.row_);
-    rowid = row_->GetRowId();
+TableIterator::TableIterator(const TableIterator &other)
+    : this_heap_(other.this_heap_), rid(other.rid), strategy_(other.strategy_) {
+  if (other.page_ != nullptr) {
+    // the page is resident as long as `other` pins it, the copy takes a pin of its own
+    page_ = this_heap_->buffer_pool_manager_->FetchPage(rid.GetPageId(), strategy_);
   }
-  else row_ = nullptr;
-  this_heap_ = other.this_heap_;
-  rid.Set(rowid.GetPageId(), rowid.GetSlotNum());
 }
 
-TableIterator::~TableIterator() {
-  if(row_ != nullptr) delete row_;
+TableIterator::TableIterator(TableIterator &&other) noexcept
+    : this_heap_(other.this_heap_), page_(other.page_), rid(other.rid), strategy_(other.strategy_) {
+  other.page_ = nullptr;
+  other.rid.Set(INVALID_PAGE_ID, 0);
 }
 
+TableIterator::~TableIterator() { Release(); }
+
+TableIterator &TableIterator::operator=(const TableIterator &itr) {
+  if (this != &itr) {
+    *this = TableIterator(itr);
+  }
+  return *this;
+}
+
+TableIterator &TableIterator::operator=(TableIterator &&itr) noexcept {
+  if (this != &itr) {
+    Release();
+    this_heap_ = itr.this_heap_;
+    page_ = itr.page_;
+    rid = itr.rid;
+    strategy_ = itr.strategy_;
+    materialized_ = false;
+    itr.page_ = nullptr;
+    itr.rid.Set(INVALID_PAGE_ID, 0);
+  }
+  return *this;
+}
 
 const Row &TableIterator::operator*() {
-  return *row_;
+  if (!materialized_) {
+    GetRowView().Materialize(&row_, this_heap_->schema_);
+    materialized_ = true;
+  }
+  return row_;
 }
 
 Row *TableIterator::operator->() {
-  return row_;
+  operator*();
+  return &row_;
+}
+
+RowView TableIterator::GetRowView() const {
+  ASSERT(page_ != nullptr, "[ ERROR ] - cannot view the tuple of the end iterator");
+  if (this_heap_->GetLayout() == TableLayout::kPax) {
+    auto pax_page = reinterpret_cast<PaxPage *>(page_);
+    ASSERT(pax_page->IsLive(rid.GetSlotNum()), "[ ERROR ] - the tuple under the iterator was deleted");
+    return RowView(pax_page, rid);
+  }
+  uint32_t tuple_size = 0;
+  char *data = reinterpret_cast<TablePage *>(page_)->GetTupleData(rid.GetSlotNum(), &tuple_size);
+  ASSERT(data != nullptr, "[ ERROR ] - the tuple under the iterator was deleted");
+  return RowView(data, tuple_size, rid, this_heap_);
 }
 
 // ++iter
 TableIterator &TableIterator::operator++() {
-  // 首先，要获取当前元组所在的磁盘页
-  //  ASSERT(false, "not implement yet");
-  ASSERT(row_ != nullptr, "[ ERROR ] - cannot do ++ operation on a null iterator");
-  page_id_t page_id = rid.GetPageId();
-  ASSERT(page_id != INVALID_PAGE_ID, "[ ERROR ] - cannot do ++ operation on end iterator");
-  TablePage *page = reinterpret_cast<TablePage *>(this_heap_->buffer_pool_manager_->FetchPage(page_id));
-  ASSERT(page_id == page->GetPageId(), "[ ERROR ] - page_id == page->GetPageId() should be true");
-  RowId nextid;
-  // 搜索下一个可用的页面
-  if (page->GetNextTupleRid(rid, &nextid)) {
-    row_->GetFields().clear();
-    rid.Set(nextid.GetPageId(), nextid.GetSlotNum());
-    row_->SetRowId(rid);
-    this_heap_->GetTuple(row_, nullptr);
-    row_->SetRowId(rid);
-    this_heap_->buffer_pool_manager_->UnpinPage(page_id, false);
+  ASSERT(page_ != nullptr, "[ ERROR ] - cannot do ++ operation on end iterator");
+  StatsScope scope(this_heap_->GetAccessStats());
+  materialized_ = false;
+  // the next tuple of the pinned page
+  RowId next_rid;
+  auto get_next_tuple_rid = [&](auto page) { return page->GetNextTupleRid(rid, &next_rid); };
+  if (this_heap_->VisitPage(page_, get_next_tuple_rid)) {
+    rid = next_rid;
     return *this;
   }
-  page_id_t next_page_id = INVALID_PAGE_ID;
-  while ((next_page_id = page->GetNextPageId()) != INVALID_PAGE_ID) {
-    TablePage *next_page = reinterpret_cast<TablePage *>(this_heap_->buffer_pool_manager_->FetchPage(next_page_id));
-    this_heap_->buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
-    page = next_page;
-    if (page->GetFirstTupleRid(&nextid)) {
-      row_->GetFields().clear();
-      rid = nextid;
-      row_->SetRowId(nextid);
-      this_heap_->GetTuple(row_, nullptr);
-      row_->SetRowId(rid);
-      this_heap_->buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  // otherwise the first tuple of the following pages, the current page is released once the next one is pinned
+  auto buffer_pool_manager = this_heap_->buffer_pool_manager_;
+  auto get_first_tuple_rid = [&](auto page) { return page->GetFirstTupleRid(&next_rid); };
+  page_id_t next_page_id;
+  while ((next_page_id = reinterpret_cast<TablePage *>(page_)->GetNextPageId()) != INVALID_PAGE_ID) {
+    auto next_page = buffer_pool_manager->FetchPage(next_page_id, strategy_);
+    ASSERT(next_page != nullptr, "[ ERROR ] - cannot fetch the next page of the table");
+    buffer_pool_manager->UnpinPage(page_->GetPageId(), false);
+    page_ = next_page;
+    buffer_pool_manager->ReadAhead(next_page_id, reinterpret_cast<TablePage *>(page_)->GetNextPageId(), strategy_);
+    if (this_heap_->VisitPage(page_, get_first_tuple_rid)) {
+      rid = next_rid;
       return *this;
     }
   }
-  // 到这里，说明咩有元组了
+  Release();
   rid.Set(INVALID_PAGE_ID, 0);
-  //  row_ = nullptr;
-  this_heap_->buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
   return *this;
 }
 
 // iter++
 TableIterator TableIterator::operator++(int) {
-  Row* row_next = new Row(*(this->row_));
-  TableHeap* this_heap_next = this->this_heap_;
-  RowId rid_next = this->rid;
+  TableIterator old(*this);
   ++(*this);
-  return TableIterator(row_next, this_heap_next, rid_next);
+  return old;
+}
+
+void TableIterator::Release() {
+  if (page_ != nullptr) {
+    this_heap_->buffer_pool_manager_->UnpinPage(page_->GetPageId(), false);
+    page_ = nullptr;
+  }
 }
@@ -0,0 +1,103 @@
+#include "buffer/background_writer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+
+static std::string ReadFromDisk(DiskManager *disk_manager, page_id_t page_id) {
+  char data[PAGE_SIZE];
+  disk_manager->ReadPage(page_id, data);
+  return std::string(data);
+}
+
+TEST(BackgroundWriterTest, FlushDirtyPagesTest) {
+  const std::string db_name = "bgwriter_test.db";
+  const size_t buffer_pool_size = 10;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+
+  page_id_t page_id;
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    auto *page = bpm->NewPage(page_id);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+    bpm->UnpinPage(page_id, true);
+  }
+  // Scenario: a pinned dirty page is never cleaned ahead of eviction.
+  bpm->FetchPage(0);
+
+  // Scenario: half of the frames must be clean, the dirty pages with the lowest page ids are written first.
+  EXPECT_EQ(5, bpm->FlushDirtyPages(0.5, 100));
+  EXPECT_EQ(0, bpm->FlushDirtyPages(0.5, 100));
+  EXPECT_EQ("", ReadFromDisk(disk_manager, 0));
+  for (page_id_t i = 1; i <= 5; i++) {
+    EXPECT_EQ("page-" + std::to_string(i), ReadFromDisk(disk_manager, i));
+  }
+  EXPECT_EQ("", ReadFromDisk(disk_manager, 6));
+
+  // Scenario: the number of pages per call is capped.
+  EXPECT_EQ(2, bpm->FlushDirtyPages(1.0, 2));
+
+  // Scenario: a checkpoint writes everything still dirty but the pinned pages, they are written once unpinned.
+  EXPECT_EQ(2, bpm->Checkpoint());
+  EXPECT_EQ("", ReadFromDisk(disk_manager, 0));
+  EXPECT_EQ("page-9", ReadFromDisk(disk_manager, 9));
+  bpm->UnpinPage(0, false);
+  EXPECT_EQ(1, bpm->Checkpoint());
+  EXPECT_EQ("page-0", ReadFromDisk(disk_manager, 0));
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BackgroundWriterTest, ForegroundWritesTest) {
+  const std::string db_name = "bgwriter_test.db";
+  const size_t buffer_pool_size = 32;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+  BackgroundWriterOptions options;
+  options.interval_ms_ = 5;
+  options.clean_target_ = 0.5;
+  options.checkpoint_interval_ms_ = 0;
+  bpm->StartBackgroundWriter(options);
+  ASSERT_NE(nullptr, bpm->GetBackgroundWriter());
+
+  page_id_t page_id;
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    auto *page = bpm->NewPage(page_id);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+    bpm->UnpinPage(page_id, true);
+  }
+  // Scenario: the writer cleans half of the pool in the background.
+  for (int i = 0; i < 1000 && bpm->GetBackgroundWriter()->GetStats().pages_written_ < buffer_pool_size / 2; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  auto stats = bpm->GetBackgroundWriter()->GetStats();
+  EXPECT_GE(stats.pages_written_, buffer_pool_size / 2);
+  EXPECT_GT(stats.rounds_, 0);
+  EXPECT_EQ(0, stats.checkpoints_);
+
+  // Scenario: the victims of the next misses are the pages cleaned by the writer, no foreground write is needed.
+  bpm->StopBackgroundWriter();
+  EXPECT_EQ(nullptr, bpm->GetBackgroundWriter());
+  for (size_t i = 0; i < buffer_pool_size / 2; i++) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    bpm->UnpinPage(page_id, false);
+  }
+  EXPECT_EQ(0, bpm->GetStats().dirty_write_backs_);
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size / 2); i++) {
+    auto *page = bpm->FetchPage(i);
+    EXPECT_EQ("page-" + std::to_string(i), std::string(page->GetData()));
+    bpm->UnpinPage(i, false);
+  }
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
@@ -0,0 +1,77 @@
+#include "buffer/buffer_access_strategy.h"
+
+#include <cstdio>
+#include <string>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+
+/**
+ * Creates `num_cold` table pages followed by `num_hot` hot pages, flushes the hot pages and then overwrites them on
+ * disk behind the buffer pool's back. A later fetch of a hot page shows whether it stayed resident: resident pages
+ * still read "hot-<id>", evicted pages are read back from disk as "stale".
+ */
+static size_t ResidentHotPagesAfterScan(size_t num_instances, bool use_strategy) {
+  const std::string db_name = "strategy_test.db";
+  const size_t buffer_pool_size = 64;
+  const int num_cold = 500;
+  const int num_hot = 16;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager, num_instances);
+
+  std::vector<page_id_t> cold_pages, hot_pages;
+  page_id_t page_id;
+  for (int i = 0; i < num_cold; i++) {
+    bpm->NewPage(page_id);
+    bpm->UnpinPage(page_id, true);
+    cold_pages.push_back(page_id);
+  }
+  char stale[PAGE_SIZE];
+  snprintf(stale, PAGE_SIZE, "stale");
+  for (int i = 0; i < num_hot; i++) {
+    auto *page = bpm->NewPage(page_id);
+    snprintf(page->GetData(), PAGE_SIZE, "hot-%d", page_id);
+    bpm->UnpinPage(page_id, true);
+    bpm->FlushPage(page_id);
+    disk_manager->WritePage(page_id, stale);
+    hot_pages.push_back(page_id);
+  }
+
+  // Scenario: a full scan over the cold pages, with or without a ring.
+  BufferAccessStrategy strategy(8);
+  for (auto cold_page_id : cold_pages) {
+    EXPECT_NE(nullptr, bpm->FetchPage(cold_page_id, use_strategy ? &strategy : nullptr));
+    bpm->UnpinPage(cold_page_id, false);
+  }
+
+  size_t resident = 0;
+  for (auto hot_page_id : hot_pages) {
+    auto *page = bpm->FetchPage(hot_page_id);
+    if (std::string(page->GetData()) == "hot-" + std::to_string(hot_page_id)) {
+      resident++;
+    }
+    bpm->UnpinPage(hot_page_id, false);
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+  return resident;
+}
+
+TEST(BufferAccessStrategyTest, ScanKeepsWorkingSetTest) {
+  // Scenario: without a ring the scan flushes the whole pool.
+  EXPECT_EQ(0, ResidentHotPagesAfterScan(1, false));
+  // Scenario: with a ring the scan only recycles its own frames, every hot page stays resident.
+  EXPECT_EQ(16, ResidentHotPagesAfterScan(1, true));
+  EXPECT_EQ(16, ResidentHotPagesAfterScan(4, true));
+}
+
+TEST(BufferAccessStrategyTest, RingSizeTest) {
+  BufferAccessStrategy strategy(8);
+  EXPECT_EQ(8, strategy.GetRingSize());
+  EXPECT_EQ(2, strategy.GetRing(0, 4)->capacity_);
+  EXPECT_EQ(1, strategy.GetRing(0, 16)->capacity_);
+  EXPECT_EQ(8, BufferAccessStrategy(8).GetRing(0, 1)->capacity_);
+}
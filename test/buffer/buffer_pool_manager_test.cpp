@@ -33,11 +33,11 @@ TEST(BufferPoolManagerTest, BinaryDataTest) {
 
   // Insert terminal characters both in the middle and at end
   random_binary_data[PAGE_SIZE / 2] = '\0';
-  random_binary_data[PAGE_SIZE - 1] = '\0';
+  random_binary_data[PAGE_USABLE_SIZE - 1] = '\0';
 
-  // Scenario: Once we have a page, we should be able to read and write content.
-  std::memcpy(page0->GetData(), random_binary_data, PAGE_SIZE);
-  EXPECT_EQ(0, std::memcmp(page0->GetData(), random_binary_data, PAGE_SIZE));
+  // Scenario: Once we have a page, we should be able to read and write content. The checksum trailer belongs to disk.
+  std::memcpy(page0->GetData(), random_binary_data, PAGE_USABLE_SIZE);
+  EXPECT_EQ(0, std::memcmp(page0->GetData(), random_binary_data, PAGE_USABLE_SIZE));
 
   // Scenario: We should be able to create new pages until we fill up the buffer pool.
   for (size_t i = 1; i < buffer_pool_size; ++i) {
@@ -62,7 +62,7 @@ TEST(BufferPoolManagerTest, BinaryDataTest) {
   }
   // Scenario: We should be able to fetch the data we wrote a while ago.
   page0 = bpm->FetchPage(0);
-  EXPECT_EQ(0, memcmp(page0->GetData(), random_binary_data, PAGE_SIZE));
+  EXPECT_EQ(0, memcmp(page0->GetData(), random_binary_data, PAGE_USABLE_SIZE));
   EXPECT_EQ(true, bpm->UnpinPage(0, true));
 
   // Shutdown the disk manager and remove the temporary file we created.
@@ -100,17 +100,17 @@ TEST(BufferPoolManagerTest, DeletePageTest) {
 
   // Insert terminal characters both in the middle and at end
   random_binary_data[PAGE_SIZE / 2] = '\0';
-  random_binary_data[PAGE_SIZE - 1] = '\0';
+  random_binary_data[PAGE_USABLE_SIZE - 1] = '\0';
 
-  // Scenario: Once we have a page, we should be able to read and write content.
-  std::memcpy(page0->GetData(), random_binary_data, PAGE_SIZE);
-  EXPECT_EQ(0, std::memcmp(page0->GetData(), random_binary_data, PAGE_SIZE));
+  // Scenario: Once we have a page, we should be able to read and write content. The checksum trailer belongs to disk.
+  std::memcpy(page0->GetData(), random_binary_data, PAGE_USABLE_SIZE);
+  EXPECT_EQ(0, std::memcmp(page0->GetData(), random_binary_data, PAGE_USABLE_SIZE));
 
   // Scenario: We need to be able to fetch the data of the page after deleting it.
   bpm->UnpinPage(0, true);
   bpm->DeletePage(0);
   bpm->FetchPage(0);
-  EXPECT_EQ(0, std::memcmp(page0->GetData(), random_binary_data, PAGE_SIZE));
+  EXPECT_EQ(0, std::memcmp(page0->GetData(), random_binary_data, PAGE_USABLE_SIZE));
 
   // Shutdown the disk manager and remove the temporary file we created.
   disk_manager->Close();
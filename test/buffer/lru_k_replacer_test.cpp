@@ -0,0 +1,122 @@
+#include "buffer/lru_k_replacer.h"
+
+#include <list>
+#include <random>
+#include <unordered_map>
+
+#include "buffer/clock_replacer.h"
+#include "buffer/lru_replacer.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+TEST(LRUKReplacerTest, SampleTest) {
+  LRUKReplacer lru_k_replacer(7, 2);
+
+  // Scenario: frames 1-5 are accessed once, frame 1 is accessed a second time.
+  for (frame_id_t i = 1; i <= 5; i++) {
+    lru_k_replacer.RecordAccess(i);
+  }
+  lru_k_replacer.RecordAccess(1);
+  for (frame_id_t i = 1; i <= 5; i++) {
+    lru_k_replacer.Unpin(i);
+  }
+  EXPECT_EQ(5, lru_k_replacer.Size());
+
+  // Scenario: frames with a single access have an infinite distance, the earliest one goes first.
+  int value;
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(2, value);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(3, value);
+
+  // Scenario: pinned frames are never victimized, unpinning an unpinned frame has no effect.
+  lru_k_replacer.Pin(4);
+  lru_k_replacer.Unpin(5);
+  EXPECT_EQ(2, lru_k_replacer.Size());
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(5, value);
+
+  // Scenario: once every frame has k accesses, the oldest k-th most recent access goes first.
+  lru_k_replacer.RecordAccess(4);
+  lru_k_replacer.Unpin(4);
+  lru_k_replacer.RecordAccess(1);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(4, value);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+  EXPECT_FALSE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(0, lru_k_replacer.Size());
+
+  // Scenario: removed frames forget their history.
+  lru_k_replacer.RecordAccess(6);
+  lru_k_replacer.Unpin(6);
+  lru_k_replacer.Remove(6);
+  EXPECT_EQ(0, lru_k_replacer.Size());
+}
+
+/**
+ * Replays a page reference string against a replacer the way the buffer pool drives it and returns the hit rate.
+ */
+static double HitRate(Replacer *replacer, size_t pool_size, const std::vector<page_id_t> &references) {
+  std::unordered_map<page_id_t, frame_id_t> page_table;
+  std::vector<page_id_t> frame_pages(pool_size, INVALID_PAGE_ID);
+  std::list<frame_id_t> free_list;
+  for (size_t i = 0; i < pool_size; i++) {
+    free_list.emplace_back(i);
+  }
+  size_t hits = 0;
+  for (auto page_id : references) {
+    frame_id_t frame_id;
+    auto i = page_table.find(page_id);
+    if (i != page_table.end()) {
+      hits++;
+      frame_id = i->second;
+      replacer->Pin(frame_id);
+    } else {
+      if (!free_list.empty()) {
+        frame_id = free_list.front();
+        free_list.pop_front();
+      } else {
+        EXPECT_TRUE(replacer->Victim(&frame_id));
+        page_table.erase(frame_pages[frame_id]);
+      }
+      frame_pages[frame_id] = page_id;
+      page_table[page_id] = frame_id;
+    }
+    replacer->RecordAccess(frame_id);
+    replacer->Unpin(frame_id);
+  }
+  return static_cast<double>(hits) / references.size();
+}
+
+TEST(LRUKReplacerTest, HitRateBenchmark) {
+  const size_t pool_size = 256;
+  const page_id_t hot_pages = 192;
+  const page_id_t table_pages = 4096;
+  const int rounds = 20;
+
+  // Mixed workload: point lookups on a hot index, interleaved with sequential scans over a large table.
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<page_id_t> hot(0, hot_pages - 1);
+  std::vector<page_id_t> references;
+  page_id_t scan_position = 0;
+  for (int r = 0; r < rounds; r++) {
+    for (int i = 0; i < 2000; i++) {
+      references.push_back(hot(rng));
+    }
+    for (int i = 0; i < 512; i++) {
+      references.push_back(hot_pages + scan_position);
+      scan_position = (scan_position + 1) % table_pages;
+    }
+  }
+
+  LRUReplacer lru_replacer(pool_size);
+  CLOCKReplacer clock_replacer(pool_size);
+  LRUKReplacer lru_k_replacer(pool_size);
+  double lru = HitRate(&lru_replacer, pool_size, references);
+  double clock = HitRate(&clock_replacer, pool_size, references);
+  double lru_k = HitRate(&lru_k_replacer, pool_size, references);
+  LOG(INFO) << "Hit rate on point lookups mixed with scans: LRU " << lru << ", CLOCK " << clock << ", LRU-"
+            << LRUK_REPLACER_K << " " << lru_k << std::endl;
+  EXPECT_GT(lru_k, lru);
+}
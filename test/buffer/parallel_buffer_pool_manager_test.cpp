@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+TEST(ParallelBufferPoolManagerTest, RoutingTest) {
+  const std::string db_name = "pbpm_test.db";
+  const size_t buffer_pool_size = 10;
+  const size_t num_instances = 5;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager, num_instances);
+  ASSERT_EQ(num_instances, bpm->GetNumInstances());
+  ASSERT_EQ(buffer_pool_size, bpm->GetPoolSize());
+
+  // Scenario: every instance holds two frames, so the first ten pages fit into the pool.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    auto *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(i, page_id_temp);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id_temp);
+  }
+
+  // Scenario: the pool is full, page 10 goes to instance 0 whose frames are all pinned.
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id_temp));
+
+  // Scenario: freeing a frame of instance 1 does not help page 10, only a frame of instance 0 does.
+  EXPECT_TRUE(bpm->UnpinPage(1, true));
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id_temp));
+  EXPECT_TRUE(bpm->UnpinPage(0, true));
+  ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+  EXPECT_EQ(10, page_id_temp);
+  EXPECT_TRUE(bpm->UnpinPage(10, false));
+
+  // Scenario: evicted pages are read back from disk through their own instance.
+  for (page_id_t i = 0; i < 2; ++i) {
+    auto *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ("page-" + std::to_string(i), std::string(page->GetData()));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  for (page_id_t i = 2; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    EXPECT_TRUE(bpm->UnpinPage(i, true));
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(ParallelBufferPoolManagerTest, ConcurrentNewFetchTest) {
+  const std::string db_name = "pbpm_test.db";
+  const size_t buffer_pool_size = 64;
+  const size_t num_instances = 4;
+  const int num_threads = 4;
+  const int pages_per_thread = 100;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager, num_instances);
+
+  // Scenario: several threads create more pages than the pool holds, forcing concurrent evictions.
+  std::vector<std::vector<page_id_t>> created(num_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < pages_per_thread; i++) {
+        page_id_t page_id;
+        Page *page = nullptr;
+        while ((page = bpm->NewPage(page_id)) == nullptr) {
+          std::this_thread::yield();
+        }
+        snprintf(page->GetData(), PAGE_SIZE, "%d", page_id);
+        bpm->UnpinPage(page_id, true);
+        created[t].push_back(page_id);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  // Scenario: every thread reads back all the pages, including those created by other threads.
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int k = 0; k < num_threads; k++) {
+        for (auto page_id : created[(t + k) % num_threads]) {
+          Page *page = nullptr;
+          while ((page = bpm->FetchPage(page_id)) == nullptr) {
+            std::this_thread::yield();
+          }
+          EXPECT_EQ(std::to_string(page_id), std::string(page->GetData()));
+          bpm->UnpinPage(page_id, false);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+/**
+ * Fetch throughput benchmark: every thread fetches and unpins random resident pages. With a single instance all the
+ * threads serialize on one latch, with one instance per thread they mostly work on different latches.
+ */
+static double FetchThroughput(size_t num_instances, int num_threads, int fetches_per_thread) {
+  const std::string db_name = "pbpm_bench.db";
+  const size_t buffer_pool_size = 1024;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager, num_instances);
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < buffer_pool_size / 2; i++) {
+    page_id_t page_id;
+    bpm->NewPage(page_id);
+    bpm->UnpinPage(page_id, false);
+    page_ids.push_back(page_id);
+  }
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t]() {
+      std::mt19937 rng(t);
+      std::uniform_int_distribution<size_t> dist(0, page_ids.size() - 1);
+      for (int i = 0; i < fetches_per_thread; i++) {
+        page_id_t page_id = page_ids[dist(rng)];
+        bpm->FetchPage(page_id);
+        bpm->UnpinPage(page_id, false);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+  return num_threads * fetches_per_thread / seconds;
+}
+
+TEST(ParallelBufferPoolManagerTest, FetchThroughputBenchmark) {
+  const int num_threads = std::max(2u, std::thread::hardware_concurrency());
+  const int fetches_per_thread = 20000;
+  double single = FetchThroughput(1, num_threads, fetches_per_thread);
+  double parallel = FetchThroughput(num_threads, num_threads, fetches_per_thread);
+  LOG(INFO) << "Fetch throughput with " << num_threads << " threads and " << PAGE_SIZE << " byte pages: 1 instance "
+            << static_cast<long>(single) << " ops/s, " << num_threads << " instances " << static_cast<long>(parallel) << " ops/s" << std::endl;
+  EXPECT_GT(single, 0);
+  EXPECT_GT(parallel, 0);
+}
@@ -0,0 +1,103 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "buffer/buffer_pool_manager.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+/**
+ * Writes `num_pages` pages holding their own page id through a throw-away buffer pool, so that they are on disk but
+ * not resident in the buffer pool of the test.
+ */
+static void WritePages(DiskManager *disk_manager, int num_pages) {
+  auto *bpm = new BufferPoolManager(16, disk_manager);
+  page_id_t page_id;
+  for (int i = 0; i < num_pages; i++) {
+    auto *page = bpm->NewPage(page_id);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+    bpm->UnpinPage(page_id, true);
+  }
+  delete bpm;
+}
+
+TEST(ReadAheadTest, PrefetchTest) {
+  const std::string db_name = "read_ahead_test.db";
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  WritePages(disk_manager, 100);
+  auto *bpm = new BufferPoolManager(64, disk_manager, 2);
+
+  // Scenario: a prefetched page is resident afterwards, prefetching it again is a no-op.
+  EXPECT_TRUE(bpm->Prefetch(10));
+  EXPECT_FALSE(bpm->Prefetch(10));
+  EXPECT_FALSE(bpm->Prefetch(INVALID_PAGE_ID));
+  auto *page = bpm->FetchPage(10);
+  EXPECT_EQ("page-10", std::string(page->GetData()));
+  bpm->UnpinPage(10, false);
+
+  // Scenario: a sequential chain prefetches the whole window, a non sequential one only the successor.
+  bpm->ReadAhead(20, 21);
+  for (page_id_t i = 21; i < 21 + DEFAULT_READ_AHEAD_PAGES; i++) {
+    EXPECT_FALSE(bpm->Prefetch(i));
+  }
+  EXPECT_TRUE(bpm->Prefetch(21 + DEFAULT_READ_AHEAD_PAGES));
+  bpm->ReadAhead(40, 50);
+  EXPECT_FALSE(bpm->Prefetch(50));
+  EXPECT_TRUE(bpm->Prefetch(51));
+  bpm->SetReadAheadWindow(0);
+  bpm->ReadAhead(60, 61);
+  EXPECT_TRUE(bpm->Prefetch(61));
+  bpm->SetReadAheadWindow(DEFAULT_READ_AHEAD_PAGES);
+
+  // Scenario: a speculative prefetch past the last allocated page does not get in the way of allocating it.
+  bpm->ReadAhead(98, 99);
+  page_id_t page_id;
+  page = bpm->NewPage(page_id);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(100, page_id);
+  EXPECT_EQ("", std::string(page->GetData()));
+  bpm->UnpinPage(page_id, false);
+
+  // Scenario: a chain scan with read-ahead sees the right data, and prefetched frames are recycled.
+  for (page_id_t i = 0; i < 100; i++) {
+    page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ("page-" + std::to_string(i), std::string(page->GetData()));
+    bpm->ReadAhead(i, i + 1);
+    bpm->UnpinPage(i, false);
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+static double ScanSeconds(DiskManager *disk_manager, int num_pages, size_t window) {
+  auto *bpm = new BufferPoolManager(256, disk_manager);
+  bpm->SetReadAheadWindow(window);
+  auto start = std::chrono::steady_clock::now();
+  for (page_id_t i = 0; i < num_pages; i++) {
+    bpm->FetchPage(i);
+    bpm->ReadAhead(i, i + 1 < num_pages ? i + 1 : INVALID_PAGE_ID);
+    bpm->UnpinPage(i, false);
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  delete bpm;
+  return seconds;
+}
+
+TEST(ReadAheadTest, ScanBenchmark) {
+  const std::string db_name = "read_ahead_bench.db";
+  const int num_pages = 4000;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  WritePages(disk_manager, num_pages);
+  double sync = ScanSeconds(disk_manager, num_pages, 0);
+  double read_ahead = ScanSeconds(disk_manager, num_pages, DEFAULT_READ_AHEAD_PAGES);
+  LOG(INFO) << "Scan of " << num_pages << " pages: " << sync << " s without read-ahead, " << read_ahead
+            << " s with a window of " << DEFAULT_READ_AHEAD_PAGES << std::endl;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
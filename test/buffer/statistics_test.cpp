@@ -0,0 +1,98 @@
+#include "common/statistics.h"
+
+#include <cstdio>
+#include <string>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+
+TEST(StatisticsTest, CounterTest) {
+  const std::string db_name = "statistics_test.db";
+  const size_t pool_size = 10;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(pool_size, disk_manager);
+  DiskStats disk_before = disk_manager->GetStats();
+
+  // Scenario: twice as many new dirty pages as frames, every page beyond the pool size evicts a dirty victim.
+  page_id_t page_id;
+  for (size_t i = 0; i < 2 * pool_size; i++) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    bpm->UnpinPage(page_id, true);
+  }
+  BufferPoolStats stats = bpm->GetStats();
+  EXPECT_EQ(2 * pool_size, stats.new_pages_);
+  EXPECT_EQ(pool_size, stats.evictions_);
+  EXPECT_EQ(pool_size, stats.dirty_write_backs_);
+  EXPECT_EQ(0, stats.fetch_hits_);
+  EXPECT_EQ(0, stats.fetch_misses_);
+  DiskStats disk = disk_manager->GetStats();
+  EXPECT_EQ(2 * pool_size, disk.allocations_ - disk_before.allocations_);
+  EXPECT_GE(disk.writes_ - disk_before.writes_, pool_size);
+  EXPECT_EQ(disk.writes_ * PAGE_SIZE, disk.bytes_written_);
+
+  // Scenario: a resident page is a hit, an evicted one a miss which reads from disk.
+  ASSERT_NE(nullptr, bpm->FetchPage(page_id));
+  bpm->UnpinPage(page_id, false);
+  ASSERT_NE(nullptr, bpm->FetchPage(0));
+  bpm->UnpinPage(0, false);
+  stats = bpm->GetStats();
+  EXPECT_EQ(1, stats.fetch_hits_);
+  EXPECT_EQ(1, stats.fetch_misses_);
+  EXPECT_EQ(disk.reads_ + 1, disk_manager->GetStats().reads_);
+
+  // Scenario: flushing counts the written pages.
+  EXPECT_TRUE(bpm->FlushPage(page_id));
+  EXPECT_EQ(1, bpm->GetStats().pages_flushed_);
+
+  delete bpm;
+  disk_manager->Close();
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(StatisticsTest, StatsScopeTest) {
+  const std::string db_name = "statistics_scope_test.db";
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(4, disk_manager);
+  page_id_t page_id;
+  for (int i = 0; i < 8; i++) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    bpm->UnpinPage(page_id, true);
+  }
+  AccessStats table;
+  AccessStats index;
+
+  // Scenario: fetches outside a scope are charged to nobody.
+  EXPECT_EQ(nullptr, StatsScope::Current());
+  bpm->FetchPage(7);
+  bpm->UnpinPage(7, false);
+  EXPECT_EQ(0, table.GetFetchHits() + table.GetFetchMisses());
+
+  // Scenario: the innermost scope owns the fetches, leaving it restores the outer one.
+  {
+    StatsScope table_scope(&table);
+    bpm->FetchPage(7);
+    bpm->UnpinPage(7, false);
+    {
+      StatsScope index_scope(&index);
+      EXPECT_EQ(&index, StatsScope::Current());
+      bpm->FetchPage(0);
+      bpm->UnpinPage(0, false);
+    }
+    EXPECT_EQ(&table, StatsScope::Current());
+    bpm->FetchPage(1);
+    bpm->UnpinPage(1, false);
+  }
+  EXPECT_EQ(nullptr, StatsScope::Current());
+  EXPECT_EQ(1, table.GetFetchHits());
+  EXPECT_EQ(1, table.GetFetchMisses());
+  EXPECT_EQ(0, index.GetFetchHits());
+  EXPECT_EQ(1, index.GetFetchMisses());
+
+  delete bpm;
+  disk_manager->Close();
+  delete disk_manager;
+  remove(db_name.c_str());
+}
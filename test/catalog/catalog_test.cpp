@@ -124,4 +124,42 @@ TEST(CatalogTest, CatalogIndexTest) {
     ASSERT_EQ(rid.Get(), ret_02[i].Get());
   }
   delete db_02;
-}
\ No newline at end of file
+}
+TEST(CatalogTest, CatalogDropTableTest) {
+  auto db = new DBStorageEngine(db_file_name, true);
+  auto &catalog = db->catalog_mgr_;
+  auto allocated_pages = [&]() {
+    return reinterpret_cast<DiskFileMetaPage *>(db->disk_mgr_->GetMetaData())->GetAllocatedPages();
+  };
+  auto make_schema = []() {
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                     new Column("name", TypeId::kTypeChar, 512, 1, true, false)};
+    return new TableSchema(columns);
+  };
+  Transaction txn;
+  std::string name(500, 'x');
+  // Scenario: dropping a table gives back its meta page, its pages and the pages it reserved.
+  uint32_t allocated = allocated_pages();
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("table-1", make_schema(), &txn, table_info));
+  for (int i = 0; i < 100; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i),
+                              Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), 500, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, nullptr));
+  }
+  ASSERT_GT(allocated_pages(), allocated + 10);
+  ASSERT_EQ(DB_SUCCESS, catalog->DropTable("table-1"));
+  EXPECT_EQ(allocated, allocated_pages());
+  ASSERT_EQ(DB_TABLE_NOT_EXIST, catalog->GetTable("table-1", table_info));
+  // Scenario: the indexes of a dropped table go along with it, a new table of the same name has none.
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("table-1", make_schema(), &txn, table_info));
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateIndex("table-1", "index-1", {"id"}, &txn, index_info, "bptree"));
+  ASSERT_EQ(DB_SUCCESS, catalog->DropTable("table-1"));
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("table-1", make_schema(), &txn, table_info));
+  std::vector<IndexInfo *> indexes;
+  catalog->GetTableIndexes("table-1", indexes);
+  EXPECT_TRUE(indexes.empty());
+  delete db;
+}
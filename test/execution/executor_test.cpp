@@ -1,13 +1,38 @@
 //
 // Created by njz on 2023/1/26.
 //
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+#include "executor/bulk_loader.h"
+#include "executor/compiled_predicate.h"
 #include "executor/plans/delete_plan.h"
 #include "executor/plans/insert_plan.h"
 #include "executor/plans/seq_scan_plan.h"
 #include "executor/plans/index_scan_plan.h"
 #include "executor/plans/update_plan.h"
 #include "executor/plans/values_plan.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "executor/executors/values_executor.h"
 #include "executor_test_util.h"  // NOLINT
+#include "planner/expressions/logic_expression.h"
+
+// every heap allocation of the test binary is counted
+static std::atomic<size_t> heap_allocations{0};
+
+void *operator new(size_t size) {
+  heap_allocations++;
+  if (void *p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, size_t) noexcept { std::free(p); }
 
 // SELECT id FROM table-1 WHERE id < 500
 TEST_F(ExecutorTest, SimpleSeqScanTest) {
@@ -30,6 +55,193 @@ TEST_F(ExecutorTest, SimpleSeqScanTest) {
   for (const auto &row : result_set) {
     ASSERT_TRUE(row.GetField(0)->CompareLessThan(Field(kTypeInt, 500)));
   }
+  // the rows of the result are carved from the arena of the query
+  ASSERT_EQ(GetExecutorContext()->GetArena(), result_set[0].GetArena());
+  ArenaStats stats = GetExecutionEngine()->GetLastQueryArenaStats();
+  ASSERT_GE(stats.allocations_, 2 * result_set.size());
+  ASSERT_GE(stats.peak_bytes_, stats.bytes_allocated_);
+}
+
+// SELECT id, account FROM table-1 WHERE id < 500, one row at a time
+TEST_F(ExecutorTest, SeqScanInPlaceTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  const Schema *schema = table_info->GetSchema();
+  auto col_id = MakeColumnValueExpression(*schema, 0, "id");
+  auto col_account = MakeColumnValueExpression(*schema, 0, "account");
+  auto const500 = MakeConstantValueExpression(Field(kTypeInt, 500));
+  auto predicate = MakeComparisonExpression(col_id, const500, "<");
+  auto out_schema = MakeOutputSchema({{"id", col_id}, {"account", col_account}});
+  auto plan = make_shared<SeqScanPlanNode>(out_schema, table_info->GetTableName(), predicate);
+  SeqScanExecutor executor(GetExecutorContext(), plan.get());
+  executor.Init();
+  // Scenario: the first row sets up the fields of the caller's row, the following ones overwrite them in place
+  // without a single heap allocation, as the columns are fixed-width. A call moving the scan to the next page may
+  // allocate in the buffer pool, it is left out.
+  Row row(GetExecutorContext()->GetArena());
+  RowId rid;
+  ASSERT_TRUE(executor.Next(&row, &rid));
+  Field *id = row.GetField(0);
+  size_t arena_allocations = GetExecutorContext()->GetArena()->GetStats().allocations_;
+  std::vector<size_t> allocations;
+  std::vector<page_id_t> pages;
+  allocations.reserve(1000);
+  pages.reserve(1000);
+  pages.push_back(rid.GetPageId());
+  Field limit(kTypeInt, 500);
+  bool in_place = true;
+  size_t before = heap_allocations;
+  while (executor.Next(&row, &rid)) {
+    allocations.push_back(heap_allocations - before);
+    pages.push_back(rid.GetPageId());
+    in_place = in_place && row.GetField(0) == id && row.GetField(0)->CompareLessThan(limit) == CmpBool::kTrue;
+    before = heap_allocations;
+  }
+  ASSERT_EQ(499, allocations.size());
+  ASSERT_TRUE(in_place);
+  ASSERT_EQ(arena_allocations, GetExecutorContext()->GetArena()->GetStats().allocations_);
+  for (size_t i = 0; i + 1 < allocations.size(); i++) {
+    // the i-th call returned the row at pages[i + 1] and moved the scan on to the row at pages[i + 2]
+    if (pages[i + 1] == pages[i + 2]) {
+      ASSERT_EQ(0, allocations[i]);
+    }
+  }
+}
+
+// SELECT id, account FROM table-1 WHERE id >= 200 AND (id < 1800 OR account > 0), a batch at a time
+TEST_F(ExecutorTest, SeqScanBatchTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  TableHeap *table_heap = table_info->GetTableHeap();
+  // enough rows for a few batches
+  for (int i = 1000; i < 2500; i++) {
+    std::vector<Field> fields = {Field(kTypeInt, i), Field(kTypeChar, const_cast<char *>("batch"), 5, false),
+                                 Field(kTypeFloat, static_cast<float>(i % 2 == 0 ? 1 : -1))};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+  }
+  const Schema *schema = table_info->GetSchema();
+  auto col_id = MakeColumnValueExpression(*schema, 0, "id");
+  auto col_account = MakeColumnValueExpression(*schema, 0, "account");
+  auto id_from = MakeComparisonExpression(col_id, MakeConstantValueExpression(Field(kTypeInt, 200)), ">=");
+  auto id_to = MakeComparisonExpression(col_id, MakeConstantValueExpression(Field(kTypeInt, 1800)), "<");
+  auto positive = MakeComparisonExpression(col_account, MakeConstantValueExpression(Field(kTypeFloat, 0.f)), ">");
+  auto predicate = std::make_shared<LogicExpression>(
+      id_from, std::make_shared<LogicExpression>(id_to, positive, LogicType::Or), LogicType::And);
+  auto out_schema = MakeOutputSchema({{"id", col_id}, {"account", col_account}});
+  auto plan = make_shared<SeqScanPlanNode>(out_schema, table_info->GetTableName(), predicate);
+  // Scenario: every batch holds at most a chunk of rows, the selected ones satisfy the predicate in ascending order.
+  SeqScanExecutor batch_executor(GetExecutorContext(), plan.get());
+  batch_executor.Init();
+  DataChunk chunk;
+  size_t batches = 0;
+  size_t batch_rows = 0;
+  while (batch_executor.NextBatch(chunk)) {
+    batches++;
+    ASSERT_EQ(2, chunk.GetColumnCount());
+    ASSERT_LE(chunk.GetCount(), chunk.GetSize());
+    ASSERT_LE(chunk.GetSize(), DATA_CHUNK_CAPACITY);
+    const int32_t *ids = chunk.GetColumn(0).GetData<int32_t>();
+    const float *accounts = chunk.GetColumn(1).GetData<float>();
+    for (uint32_t i = 0; i < chunk.GetCount(); i++) {
+      uint32_t index = chunk.GetSelection(i);
+      ASSERT_TRUE(i == 0 || chunk.GetSelection(i - 1) < index);
+      ASSERT_FALSE(chunk.GetColumn(0).IsNull(index));
+      ASSERT_TRUE(ids[index] >= 200 && (ids[index] < 1800 || accounts[index] > 0));
+    }
+    batch_rows += chunk.GetCount();
+  }
+  ASSERT_GE(batches, 3);
+  ASSERT_EQ(0, chunk.GetCount());
+  // Scenario: the rows served one at a time out of the batches are the same ones.
+  SeqScanExecutor row_executor(GetExecutorContext(), plan.get());
+  row_executor.Init();
+  Row row;
+  RowId rid;
+  size_t rows = 0;
+  while (row_executor.Next(&row, &rid)) {
+    ASSERT_EQ(rid, row.GetRowId());
+    rows++;
+  }
+  ASSERT_EQ(rows, batch_rows);
+  ASSERT_EQ(1600 + 350, rows);
+  // Scenario: an executor producing rows one at a time fills a batch through the adapter.
+  std::vector<std::vector<AbstractExpressionRef>> raw_values;
+  for (int i = 0; i < 3; i++) {
+    raw_values.push_back({MakeConstantValueExpression(Field(kTypeInt, i)),
+                          MakeConstantValueExpression(Field(kTypeChar, const_cast<char *>("abc"), i, false))});
+  }
+  auto value_plan = std::make_shared<ValuesPlanNode>(nullptr, raw_values);
+  ValuesExecutor values_executor(GetExecutorContext(), value_plan.get());
+  values_executor.Init();
+  ASSERT_TRUE(values_executor.NextBatch(chunk));
+  ASSERT_EQ(3, chunk.GetCount());
+  ASSERT_EQ(2, chunk.GetColumn(1).GetData<CharValue>()[2].len_);
+  chunk.GetRow(chunk.GetSelection(1), &row);
+  ASSERT_EQ("a", row.GetField(1)->toString());
+  ASSERT_FALSE(values_executor.NextBatch(chunk));
+}
+
+// WHERE clauses over every row of table-1, compiled and evaluated as is
+TEST_F(ExecutorTest, CompiledPredicateTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  TableHeap *table_heap = table_info->GetTableHeap();
+  std::vector<Field> null_fields = {Field(kTypeInt, 1000), Field(kTypeChar), Field(kTypeFloat)};
+  Row null_row(null_fields);
+  ASSERT_TRUE(table_heap->InsertTuple(null_row, nullptr));
+  const Schema *schema = table_info->GetSchema();
+  auto col_id = MakeColumnValueExpression(*schema, 0, "id");
+  auto col_name = MakeColumnValueExpression(*schema, 0, "name");
+  auto col_account = MakeColumnValueExpression(*schema, 0, "account");
+  auto const500 = MakeConstantValueExpression(Field(kTypeInt, 500));
+  auto const_zero = MakeConstantValueExpression(Field(kTypeFloat, 0.f));
+  auto const_m = MakeConstantValueExpression(Field(kTypeChar, const_cast<char *>("m"), 1, false));
+  auto const_null = MakeConstantValueExpression(Field(kTypeFloat));
+  // a comparison of every type with every operator, with NULL, and of NULL
+  std::vector<AbstractExpressionRef> comparisons;
+  for (std::string op : {"=", "<>", "<", "<=", ">", ">="}) {
+    comparisons.push_back(MakeComparisonExpression(col_id, const500, op));
+    comparisons.push_back(MakeComparisonExpression(col_account, const_zero, op));
+    comparisons.push_back(MakeComparisonExpression(col_name, const_m, op));
+    comparisons.push_back(MakeComparisonExpression(col_account, const_null, op));
+  }
+  comparisons.push_back(MakeComparisonExpression(col_name, MakeConstantValueExpression(Field(kTypeChar)), "is"));
+  comparisons.push_back(MakeComparisonExpression(col_account, const_null, "not"));
+  std::vector<AbstractExpressionRef> predicates = comparisons;
+  for (size_t i = 0; i + 1 < comparisons.size(); i++) {
+    predicates.push_back(std::make_shared<LogicExpression>(comparisons[i], comparisons[i + 1], LogicType::And));
+    predicates.push_back(std::make_shared<LogicExpression>(comparisons[i], comparisons[i + 1], LogicType::Or));
+  }
+  // a constant on the left is not compiled, it is evaluated as is
+  predicates.push_back(MakeComparisonExpression(const500, col_id, "<"));
+  std::vector<CompiledPredicate> compiled;
+  for (auto &predicate : predicates) {
+    compiled.emplace_back(predicate);
+  }
+  // Scenario: every compiled predicate holds for the rows its expression evaluates to 1 for, and the compiled
+  // comparisons allocate nothing.
+  size_t rows = 0;
+  size_t id_below_500 = 0;
+  size_t kernel_allocations = 0;
+  for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); ++it) {
+    const Row &row = *it;
+    for (size_t i = 0; i < predicates.size(); i++) {
+      bool expected = Field(kTypeInt, 1).CompareEquals(predicates[i]->Evaluate(&row)) == CmpBool::kTrue;
+      ASSERT_EQ(expected, compiled[i].Evaluate(row)) << "predicate " << i << " row " << rows;
+    }
+    size_t before = heap_allocations;
+    for (size_t i = 0; i < comparisons.size(); i++) {
+      compiled[i].Evaluate(row);
+    }
+    kernel_allocations += heap_allocations - before;
+    id_below_500 += compiled[8].Evaluate(row);  // id < 500
+    rows++;
+  }
+  ASSERT_EQ(1001, rows);
+  ASSERT_EQ(500, id_below_500);
+  ASSERT_EQ(0, kernel_allocations);
+  ASSERT_TRUE(CompiledPredicate().Evaluate(null_row));
 }
 
 // DELETE FROM table-1 WHERE id == 50;
@@ -113,6 +325,56 @@ TEST_F(ExecutorTest, SimpleRawInsertTest) {
   ASSERT_TRUE(result_set[0].GetField(2)->CompareEquals(Field(kTypeFloat, static_cast<float>(2.33))));
 }
 
+// INSERT INTO table-1 VALUES (2000, "r0", 0.5), (2001, "r1", 1.5), ...;
+TEST_F(ExecutorTest, MultiRowInsertTest) {
+  // One values plan carrying more rows than an insert batch
+  const int row_nums = DEFAULT_INSERT_BATCH_SIZE + 44;
+  std::vector<std::string> names;
+  std::vector<std::vector<AbstractExpressionRef>> raw_values;
+  for (int i = 0; i < row_nums; i++) {
+    names.push_back("r" + std::to_string(i));
+    raw_values.push_back({MakeConstantValueExpression(Field(kTypeInt, 2000 + i)),
+                          MakeConstantValueExpression(Field(kTypeChar, const_cast<char *>(names.back().c_str()),
+                                                            names.back().size(), true)),
+                          MakeConstantValueExpression(Field(kTypeFloat, static_cast<float>(i + 0.5)))});
+  }
+  auto value_plan = std::make_shared<ValuesPlanNode>(nullptr, raw_values);
+  auto insert_plan = std::make_shared<InsertPlanNode>(nullptr, value_plan, "table-1");
+
+  // Every row is reported as inserted
+  std::vector<Row> result_set{};
+  ASSERT_EQ(DB_SUCCESS, GetExecutionEngine()->ExecutePlan(insert_plan, &result_set, GetTxn(), GetExecutorContext()));
+  ASSERT_EQ(row_nums, result_set.size());
+  result_set.clear();
+
+  // Without a result set the rows the executors pass up are not kept, the arena of the query does not grow with them
+  std::vector<std::vector<AbstractExpressionRef>> more_values;
+  for (int i = 0; i < row_nums; i++) {
+    more_values.push_back({MakeConstantValueExpression(Field(kTypeInt, 5000 + i)), raw_values[i][1], raw_values[i][2]});
+  }
+  auto more_insert_plan =
+      std::make_shared<InsertPlanNode>(nullptr, std::make_shared<ValuesPlanNode>(nullptr, more_values), "table-1");
+  size_t arena_allocations = GetExecutorContext()->GetArena()->GetStats().allocations_;
+  ASSERT_EQ(DB_SUCCESS, GetExecutionEngine()->ExecutePlan(more_insert_plan, nullptr, GetTxn(), GetExecutorContext()));
+  EXPECT_LT(GetExecutorContext()->GetArena()->GetStats().allocations_ - arena_allocations, row_nums);
+
+  // SELECT * FROM table-1 where id >= 2000;
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  const Schema *schema = table_info->GetSchema();
+  auto col_a = MakeColumnValueExpression(*schema, 0, "id");
+  auto const2000 = MakeConstantValueExpression(Field(kTypeInt, 2000));
+  auto predicate = MakeComparisonExpression(col_a, const2000, ">=");
+  auto scan_plan = make_shared<SeqScanPlanNode>(schema, table_info->GetTableName(), predicate);
+  GetExecutionEngine()->ExecutePlan(scan_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(2 * row_nums, result_set.size());
+  for (const auto &row : result_set) {
+    int i = std::stoi(row.GetField(0)->toString()) % 1000;
+    ASSERT_TRUE(row.GetField(1)->CompareEquals(
+        Field(kTypeChar, const_cast<char *>(names[i].c_str()), names[i].size(), false)));
+  }
+}
+
 // UPDATE table-1 SET name = "minisql" where id = 500;
 TEST_F(ExecutorTest, SimpleUpdateTest) {
   // Construct a sequential scan of the table
@@ -183,3 +445,90 @@ TEST_F(ExecutorTest, SimpleIndexScanTest) {
     ASSERT_TRUE(row.GetField(0)->CompareLessThan(Field(kTypeInt, 500)));
   }
 }
+
+// COPY table-1 FROM "executor_test.csv";
+TEST_F(ExecutorTest, BulkLoadTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  const Schema *schema = table_info->GetSchema();
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "PRIMARY_KEY_", {"id"}, GetTxn(),
+                                                                         index_info, "bptree"));
+  auto count_rows = [&](int min_id) {
+    auto col_a = MakeColumnValueExpression(*schema, 0, "id");
+    auto predicate = MakeComparisonExpression(col_a, MakeConstantValueExpression(Field(kTypeInt, min_id)), ">=");
+    auto scan_plan = make_shared<SeqScanPlanNode>(schema, table_info->GetTableName(), predicate);
+    std::vector<Row> result_set{};
+    GetExecutionEngine()->ExecutePlan(scan_plan, &result_set, GetTxn(), GetExecutorContext());
+    return result_set.size();
+  };
+  const std::string file_name = "executor_test.csv";
+  // Enough records to span more than one chunk, with quoted fields, NULLs and CRLF line breaks in between
+  const int row_nums = 30000;
+  const std::string padding(48, '-');
+  {
+    std::ofstream file(file_name, std::ios::binary);
+    for (int i = 0; i < row_nums; i++) {
+      switch (i % 4) {
+        case 0:
+          file << 10000 + i << ",name-" << i << padding << "," << i * 0.5 << "\n";
+          break;
+        case 1:
+          file << 10000 + i << ",\"a,\"\"b\"\"\nc" << padding << "\",\r\n";
+          break;
+        case 2:
+          file << 10000 + i << ",," << -i << "\n";
+          break;
+        default:
+          file << "\n" << 10000 + i << ",\"\",1e3\n";
+      }
+    }
+    ASSERT_GT(file.tellp(), BULK_LOAD_CHUNK_SIZE);
+  }
+  BulkLoader loader(GetExecutorContext(), table_info);
+  ASSERT_EQ(row_nums, loader.Load(file_name));
+  ASSERT_EQ(row_nums, count_rows(10000));
+
+  // Every row is found through the index and holds the values of its record
+  for (int i : {0, 1, 2, 3, row_nums - 1}) {
+    std::vector<Field> key_fields{Field(kTypeInt, 10000 + i)};
+    std::vector<RowId> rids;
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(Row(key_fields), rids, GetTxn(), "="));
+    ASSERT_EQ(1, rids.size());
+    Row row(rids[0]);
+    ASSERT_TRUE(table_info->GetTableHeap()->GetTuple(&row, GetTxn()));
+    switch (i % 4) {
+      case 0:
+        EXPECT_EQ("name-" + std::to_string(i) + padding, row.GetField(1)->toString());
+        EXPECT_TRUE(row.GetField(2)->CompareEquals(Field(kTypeFloat, static_cast<float>(i * 0.5))));
+        break;
+      case 1:
+        EXPECT_EQ("a,\"b\"\nc" + padding, row.GetField(1)->toString());
+        EXPECT_TRUE(row.GetField(2)->IsNull());
+        break;
+      case 2:
+        EXPECT_TRUE(row.GetField(1)->IsNull());
+        EXPECT_TRUE(row.GetField(2)->CompareEquals(Field(kTypeFloat, static_cast<float>(-i))));
+        break;
+      default:
+        EXPECT_FALSE(row.GetField(1)->IsNull());
+        EXPECT_EQ(0, row.GetField(1)->GetLength());
+        EXPECT_TRUE(row.GetField(2)->CompareEquals(Field(kTypeFloat, 1000.f)));
+    }
+  }
+
+  // A malformed record, a NULL key or a duplicate key anywhere in the file loads nothing at all
+  for (const char *bad_record : {"abc,x,1", "1,x,1,2", ",x,1", "\"1,x,1", "500,x,1", "70000,x,1"}) {
+    {
+      std::ofstream file(file_name, std::ios::binary);
+      for (int i = 0; i < 1000; i++) {
+        file << 70000 + i << ",x," << i << "\n";
+      }
+      file << bad_record << "\n";
+    }
+    EXPECT_THROW(BulkLoader(GetExecutorContext(), table_info).Load(file_name), std::string);
+  }
+  EXPECT_THROW(BulkLoader(GetExecutorContext(), table_info).Load("no_such_file.csv"), std::string);
+  ASSERT_EQ(row_nums, count_rows(10000));
+  remove(file_name.c_str());
+}
@@ -36,6 +36,10 @@ class ExecutorTest : public ::testing::Test {
   void SetUp() override {
     ::testing::Test::SetUp();
 
+    // Construct the executor engine for the test first, it opens every database file it finds and the one below is
+    // not flushed yet
+    execution_engine_ = std::make_unique<ExecuteEngine>();
+
     // Initialize the database subsystems
     db_test_ = new DBStorageEngine("executor_test.db", true);
     auto &catalog_01 = db_test_->catalog_mgr_;
@@ -59,9 +63,6 @@ class ExecutorTest : public ::testing::Test {
     }
     // Create an executor context for our executors
     exec_ctx_ = std::make_unique<ExecuteContext>(txn_, db_test_->catalog_mgr_, db_test_->bpm_);
-
-    // Construct the executor engine for the test
-    execution_engine_ = std::make_unique<ExecuteEngine>();
   }
 
   /** Called after every executor test. */
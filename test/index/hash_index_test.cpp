@@ -9,6 +9,7 @@
 #include "gtest/gtest.h"
 #include "index/comparator.h"
 #include "utils/utils.h"
+#include <set>
 #include <string>
 #include "index/generic_key.h"
 
@@ -41,14 +42,15 @@ TEST(HashIndexTests, HashIndexSimpleTest) {
     ASSERT_EQ(DB_SUCCESS, index->ScanKey(row, ret, nullptr));
     ASSERT_EQ(rid.Get(), ret[i].Get());
   }
-  // Iterator Scan
+  // Iterator Scan, the entries come in the order of their buckets
   HashIndexIterator iter = index->GetBeginIterator();
-  uint32_t i = 0;
+  std::set<uint32_t> slots;
   for (; iter != index->GetEndIterator(); ++iter) {
     ASSERT_EQ(1000, (*iter).second.GetPageId());
-    ASSERT_EQ(i, (*iter).second.GetSlotNum());
-    i++;
+    slots.insert((*iter).second.GetSlotNum());
   }
+  ASSERT_EQ(10, slots.size());
+  ASSERT_EQ(9, *slots.rbegin());
   delete index;
 }
 
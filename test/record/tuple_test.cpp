@@ -1,4 +1,5 @@
 #include <cstring>
+#include <memory>
 
 #include "common/instance.h"
 #include "gtest/gtest.h"
@@ -168,6 +169,121 @@ TEST (TupleTest, RowSerializationTest) {
   }
 }
 
+TEST(TupleTest, CompactRowFormatTest) {
+  char buffer[PAGE_SIZE];
+  std::vector<Column *> columns = {new Column("name", TypeId::kTypeChar, 64, 0, true, false),
+                                   new Column("id", TypeId::kTypeInt, 1, false, false),
+                                   new Column("note", TypeId::kTypeChar, 64, 2, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 3, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  std::vector<Field> fields = {Field(TypeId::kTypeChar, const_cast<char *>("minisql"), strlen("minisql"), false),
+                               Field(TypeId::kTypeInt, 188), Field(TypeId::kTypeChar),
+                               Field(TypeId::kTypeFloat, 19.99f)};
+  Row row(fields);
+  // Scenario: version and bitmap (2), fixed section (8), offset array (4) and the chars (7), no rid nor field count.
+  uint32_t size = row.SerializeTo(buffer, schema.get());
+  ASSERT_EQ(21, size);
+  ASSERT_EQ(size, row.GetSerializedSize(schema.get()));
+  // Scenario: any column is read on its own, and a partial read leaves the other columns NULL.
+  for (uint32_t i = 0; i < fields.size(); i++) {
+    std::unique_ptr<Field> field(Row::DeserializeField(buffer, schema.get(), i));
+    ASSERT_EQ(fields[i].IsNull(), field->IsNull());
+    if (!fields[i].IsNull()) {
+      ASSERT_EQ(CmpBool::kTrue, field->CompareEquals(fields[i]));
+    }
+  }
+  Row partial;
+  ASSERT_EQ(size, partial.DeserializeFrom(buffer, schema.get(), {3}));
+  ASSERT_EQ(fields.size(), partial.GetFieldCount());
+  ASSERT_TRUE(partial.GetField(0)->IsNull());
+  ASSERT_TRUE(partial.GetField(1)->IsNull());
+  ASSERT_EQ(CmpBool::kTrue, partial.GetField(3)->CompareEquals(fields[3]));
+  // Scenario: a value in overflow pages keeps its length and the first page of its chain.
+  Field long_name(TypeId::kTypeChar, 5000, 42);
+  fields[0] = long_name;
+  Row stub(fields);
+  ASSERT_EQ(size - 7 + 8, stub.SerializeTo(buffer, schema.get()));
+  std::unique_ptr<Field> field(Row::DeserializeField(buffer, schema.get(), 0));
+  ASSERT_TRUE(field->IsOverflow());
+  ASSERT_EQ(5000, field->GetLength());
+  ASSERT_EQ(42, field->GetOverflowPageId());
+}
+
+TEST(TupleTest, ArenaRowTest) {
+  char buffer[PAGE_SIZE];
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  std::vector<Field> fields = {Field(TypeId::kTypeInt, 188),
+                               Field(TypeId::kTypeChar, const_cast<char *>("minisql"), strlen("minisql"), false)};
+  Row(fields).SerializeTo(buffer, schema.get());
+  // Scenario: a row in an arena takes its fields and their chars from it, and so does its copy.
+  MemoryArena arena(1024);
+  Row arena_row(&arena);
+  arena_row.DeserializeFrom(buffer, schema.get());
+  ASSERT_EQ(3, arena.GetStats().allocations_);
+  Row arena_copy(arena_row);
+  ASSERT_EQ(&arena, arena_copy.GetArena());
+  ASSERT_EQ(6, arena.GetStats().allocations_);
+  ASSERT_EQ(1, arena.GetStats().blocks_);
+  // Scenario: a row on the heap copied from one in an arena owns its chars and outlives the arena memory.
+  Row heap_row;
+  heap_row = arena_row;
+  Field name(*arena_row.GetField(1));
+  arena_row.destroy();
+  arena_copy.destroy();
+  arena.Reset();
+  // the block is reused from its start
+  memset(arena.Allocate(1024, 1), 'x', 1024);
+  ASSERT_EQ(1, arena.GetStats().blocks_);
+  ASSERT_EQ("minisql", heap_row.GetField(1)->toString());
+  ASSERT_EQ("minisql", name.toString());
+  // Scenario: a large object takes a block of its own, Reset keeps one block for the next objects.
+  arena.Allocate(4096);
+  ArenaStats stats = arena.GetStats();
+  ASSERT_EQ(2, stats.blocks_);
+  ASSERT_EQ(1024 + 4096, stats.peak_bytes_);
+  arena.Reset();
+  arena.Allocate(16);
+  ASSERT_EQ(2, arena.GetStats().blocks_);
+}
+
+TEST(TupleTest, MoveTest) {
+  // Scenario: a moved field hands over its chars and is left NULL.
+  Field name(TypeId::kTypeChar, const_cast<char *>("minisql"), strlen("minisql"), true);
+  const char *chars = name.GetData();
+  Field moved(std::move(name));
+  ASSERT_EQ(chars, moved.GetData());
+  ASSERT_TRUE(name.IsNull());
+  Field assigned(TypeId::kTypeInt, 1);
+  assigned = std::move(moved);
+  ASSERT_EQ(chars, assigned.GetData());
+  // Scenario: a copy assigned field owns chars of its own.
+  Field copy(TypeId::kTypeInt, 2);
+  copy = assigned;
+  ASSERT_NE(chars, copy.GetData());
+  ASSERT_EQ("minisql", copy.toString());
+  // Scenario: a moved row hands over its fields, they are copied only into a row of another arena.
+  std::vector<Field> fields = {Field(TypeId::kTypeInt, 188), Field(TypeId::kTypeFloat, 19.99f)};
+  Row row(fields);
+  Field *first = row.GetField(0);
+  Row heap_row(std::move(row));
+  ASSERT_EQ(0, row.GetFieldCount());
+  ASSERT_EQ(first, heap_row.GetField(0));
+  MemoryArena arena;
+  Row arena_row(&arena);
+  arena_row = std::move(heap_row);
+  ASSERT_NE(first, arena_row.GetField(0));
+  ASSERT_EQ(2, arena.GetStats().allocations_);
+  // Scenario: a row filled in place keeps its fields.
+  arena_row.ResizeFields(2);
+  first = arena_row.GetField(0);
+  arena_row.SetField(0, Field(TypeId::kTypeInt, 7));
+  ASSERT_EQ(first, arena_row.GetField(0));
+  ASSERT_EQ(CmpBool::kTrue, arena_row.GetField(0)->CompareEquals(Field(TypeId::kTypeInt, 7)));
+  ASSERT_EQ(2, arena.GetStats().allocations_);
+}
+
 TEST(TupleTest, RowTest) {
   TablePage table_page;
   // create schema
@@ -1,5 +1,7 @@
 #include "storage/disk_manager.h"
 
+#include <fstream>
+#include <string>
 #include <unordered_set>
 
 #include "gtest/gtest.h"
@@ -92,4 +94,104 @@ TEST(DiskManagerTest, IsPageFreeTest) {
   EXPECT_EQ(DiskManager::BITMAP_SIZE - 2, meta_page->GetExtentUsedPage(0));
   EXPECT_EQ(DiskManager::BITMAP_SIZE - 3, meta_page->GetExtentUsedPage(1));
   remove(db_name.c_str());
-}
\ No newline at end of file
+}
+TEST(DiskManagerTest, ReadWriteSyncTest) {
+  std::string db_name = "disk_sync_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  char data[PAGE_SIZE];
+  char buf[PAGE_SIZE];
+  // Scenario: pages past the end of the file read as zeros.
+  memset(buf, 1, PAGE_SIZE);
+  disk_mgr->ReadPage(10, buf);
+  for (size_t i = 0; i < PAGE_SIZE; i++) {
+    ASSERT_EQ(0, buf[i]);
+  }
+  // Scenario: writes land in the file without any sync, a sync only happens when there is something to sync.
+  uint64_t flushes = disk_mgr->GetStats().flushes_;
+  for (page_id_t i = 0; i < 16; i++) {
+    snprintf(data, PAGE_SIZE, "page-%d", i);
+    disk_mgr->WritePage(i, data);
+  }
+  EXPECT_EQ(flushes, disk_mgr->GetStats().flushes_);
+  disk_mgr->ReadPage(7, buf);
+  EXPECT_EQ("page-7", std::string(buf));
+  disk_mgr->Sync();
+  disk_mgr->Sync();
+  EXPECT_EQ(flushes + 1, disk_mgr->GetStats().flushes_);
+  // Scenario: the pages survive reopening the file.
+  disk_mgr->Close();
+  delete disk_mgr;
+  disk_mgr = new DiskManager(db_name);
+  for (page_id_t i = 0; i < 16; i++) {
+    disk_mgr->ReadPage(i, buf);
+    EXPECT_EQ("page-" + std::to_string(i), std::string(buf));
+  }
+  disk_mgr->Close();
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, BitmapCacheTest) {
+  std::string db_name = "disk_bitmap_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  // Scenario: once the bitmap of an extent is cached, allocating, freeing and checking pages costs no I/O.
+  EXPECT_TRUE(disk_mgr->IsPageFree(0));
+  DiskStats before = disk_mgr->GetStats();
+  for (page_id_t i = 0; i < 100; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+    EXPECT_FALSE(disk_mgr->IsPageFree(i));
+  }
+  for (page_id_t i = 0; i < 100; i += 2) {
+    disk_mgr->DeAllocatePage(i);
+  }
+  DiskStats after = disk_mgr->GetStats();
+  EXPECT_EQ(before.reads_, after.reads_);
+  EXPECT_EQ(before.writes_, after.writes_);
+  // Scenario: the bitmap is written back with the meta page and survives reopening the file.
+  disk_mgr->Close();
+  delete disk_mgr;
+  disk_mgr = new DiskManager(db_name);
+  for (page_id_t i = 0; i < 100; i++) {
+    EXPECT_EQ(i % 2 == 0, disk_mgr->IsPageFree(i));
+  }
+  EXPECT_EQ(50, reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData())->GetAllocatedPages());
+  page_id_t page_id = disk_mgr->AllocatePage();
+  EXPECT_EQ(0, page_id % 2);
+  EXPECT_FALSE(disk_mgr->IsPageFree(page_id));
+  disk_mgr->Close();
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, PageSizeHeaderTest) {
+  std::string db_name = "disk_page_size_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  disk_mgr->AllocatePage();
+  disk_mgr->Close();
+  delete disk_mgr;
+  // Scenario: the file records the page size of the build which created it and opens again with it.
+  disk_mgr = new DiskManager(db_name);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  EXPECT_EQ(DISK_FILE_MAGIC_NUM, meta_page->magic_num_);
+  EXPECT_EQ(PAGE_SIZE, meta_page->page_size_);
+  EXPECT_EQ(1, meta_page->GetAllocatedPages());
+  disk_mgr->Close();
+  delete disk_mgr;
+  // Scenario: a file of another page size, or no database file at all, is rejected.
+  uint32_t header[2] = {DISK_FILE_MAGIC_NUM, PAGE_SIZE * 2};
+  {
+    std::fstream file(db_name, std::ios::in | std::ios::out | std::ios::binary);
+    file.write(reinterpret_cast<char *>(header), sizeof(header));
+  }
+  EXPECT_THROW(DiskManager{db_name}, std::runtime_error);
+  header[0] = 0x12345678;
+  {
+    std::fstream file(db_name, std::ios::in | std::ios::out | std::ios::binary);
+    file.write(reinterpret_cast<char *>(header), sizeof(header));
+  }
+  EXPECT_THROW(DiskManager{db_name}, std::runtime_error);
+  remove(db_name.c_str());
+}
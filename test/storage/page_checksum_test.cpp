@@ -0,0 +1,113 @@
+#include "storage/page_checksum.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/crc32c.h"
+#include "gtest/gtest.h"
+#include "storage/disk_manager.h"
+
+TEST(PageChecksumTest, Crc32cTest) {
+  // Scenario: the check value of CRC32C, on whichever implementation the CPU runs.
+  const std::string check = "123456789";
+  EXPECT_EQ(0xE3069283, Crc32c(check.data(), check.size()));
+  EXPECT_EQ(0xE3069283, Crc32cSoftware(check.data(), check.size()));
+  EXPECT_EQ(0, Crc32c(check.data(), 0));
+
+  // Scenario: both implementations agree on unaligned buffers of any length, and a checksum can be continued.
+  std::mt19937 rng(0);
+  std::vector<char> buffer(PAGE_SIZE + 16);
+  for (auto &c : buffer) {
+    c = static_cast<char>(rng());
+  }
+  for (size_t length : {1, 7, 8, 9, 63, 100, PAGE_SIZE - 1, PAGE_SIZE}) {
+    for (size_t offset = 0; offset < 8; offset++) {
+      uint32_t crc = Crc32c(buffer.data() + offset, length);
+      ASSERT_EQ(Crc32cSoftware(buffer.data() + offset, length), crc);
+      size_t half = length / 2;
+      ASSERT_EQ(crc, Crc32c(buffer.data() + offset + half, length - half, Crc32c(buffer.data() + offset, half)));
+    }
+  }
+}
+
+TEST(PageChecksumTest, StampVerifyTest) {
+  char page[PAGE_SIZE]{};
+  // Scenario: a page which was never written is valid as it is.
+  EXPECT_TRUE(VerifyPageChecksum(page, 5));
+  // Scenario: a stamped page is valid at its own location only, and any flipped bit is caught.
+  snprintf(page, PAGE_SIZE, "hello");
+  StampPageChecksum(page, 5);
+  EXPECT_TRUE(VerifyPageChecksum(page, 5));
+  EXPECT_FALSE(VerifyPageChecksum(page, 6));
+  page[PAGE_USABLE_SIZE - 1] ^= 0x10;
+  EXPECT_FALSE(VerifyPageChecksum(page, 5));
+}
+
+TEST(PageChecksumTest, CorruptPageTest) {
+  const std::string db_name = "page_checksum_test.db";
+  const int num_pages = 100;
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManager(16, disk_manager);
+  for (int i = 0; i < num_pages; i++) {
+    page_id_t page_id;
+    Page *page = bpm->NewPage(page_id);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+    bpm->UnpinPage(page_id, true);
+  }
+  delete bpm;
+  disk_manager->Close();
+  delete disk_manager;
+
+  // Scenario: an intact file passes the verification, whatever the number of threads.
+  ChecksumReport report = VerifyFileChecksums(db_name, 4);
+  ASSERT_TRUE(report.opened_);
+  EXPECT_EQ(num_pages + 2, report.pages_checked_);
+  EXPECT_TRUE(report.corrupt_pages_.empty());
+
+  // Scenario: one flipped byte inside logical page 42, physical page 44, is found by the verification.
+  const page_id_t corrupt_page_id = 42;
+  {
+    std::fstream file(db_name, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp((corrupt_page_id + 2) * PAGE_SIZE + 100);
+    file.put('!');
+  }
+  for (size_t num_threads : {1, 3, 8}) {
+    report = VerifyFileChecksums(db_name, num_threads);
+    ASSERT_EQ(1, report.corrupt_pages_.size());
+    EXPECT_EQ(corrupt_page_id + 2, report.corrupt_pages_[0]);
+  }
+  EXPECT_FALSE(VerifyFileChecksums("no_such_file.db", 1).opened_);
+
+  // Scenario: the disk manager rejects the page on read, the buffer pool does not hand it out.
+  disk_manager = new DiskManager(db_name);
+  bpm = new BufferPoolManager(16, disk_manager);
+  char data[PAGE_SIZE];
+  EXPECT_TRUE(disk_manager->ReadPage(corrupt_page_id - 1, data));
+  EXPECT_FALSE(disk_manager->ReadPage(corrupt_page_id, data));
+  EXPECT_EQ(1, disk_manager->GetStats().checksum_failures_);
+  EXPECT_EQ(nullptr, bpm->FetchPage(corrupt_page_id));
+  Page *page = bpm->FetchPage(corrupt_page_id + 1);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ("page-" + std::to_string(corrupt_page_id + 1), std::string(page->GetData()));
+  bpm->UnpinPage(corrupt_page_id + 1, false);
+  EXPECT_EQ(2, disk_manager->GetStats().checksum_failures_);
+  delete bpm;
+  disk_manager->Close();
+  delete disk_manager;
+
+  // Scenario: a memory mapped disk manager rejects the page as well.
+  disk_manager = new DiskManager(db_name, DiskAccessMode::kMemoryMapped);
+  bpm = new BufferPoolManager(16, disk_manager);
+  EXPECT_EQ(nullptr, bpm->FetchPage(corrupt_page_id));
+  EXPECT_NE(nullptr, bpm->FetchPage(corrupt_page_id + 1));
+  bpm->UnpinPage(corrupt_page_id + 1, false);
+  delete bpm;
+  disk_manager->Close();
+  delete disk_manager;
+  remove(db_name.c_str());
+}
@@ -1,5 +1,7 @@
 #include "storage/table_heap.h"
 
+#include <fstream>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -139,4 +141,594 @@ TEST(TableHeapTest, TableHeapSampleTest_1) {
   for (int i = 0; i < 3; i++) {
     ASSERT_EQ(CmpBool::kTrue, testUpdated.GetField(i)->CompareEquals(updated_fields->at(i)));
   }
-}
\ No newline at end of file
+}
+TEST(TableHeapTest, ContiguousAllocationTest) {
+  const std::string db_name = "table_heap_contiguous_test.db";
+  remove(db_name.c_str());
+  auto disk_mgr = new DiskManager(db_name);
+  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 512, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  // Scenario: two tables growing at the same time still get their own runs of consecutive pages.
+  TableHeap *heaps[2] = {TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr),
+                         TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr)};
+  std::string name(500, 'x');
+  // about 28 pages per table, whatever the page size
+  const int row_nums = 200 * PAGE_SIZE / 4096;
+  for (int i = 0; i < row_nums; i++) {
+    for (auto heap : heaps) {
+      Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), 500, true)};
+      Row row(fields);
+      ASSERT_TRUE(heap->InsertTuple(row, nullptr));
+    }
+  }
+  // the pages of the last run of each table which no page was taken from yet
+  uint32_t unused = 0;
+  for (auto heap : heaps) {
+    size_t num_pages = 0;
+    size_t num_sequential = 0;
+    page_id_t page_id = heap->GetFirstPageId();
+    while (page_id != INVALID_PAGE_ID) {
+      auto page = reinterpret_cast<TablePage *>(bpm->FetchPage(page_id));
+      page_id_t next_page_id = page->GetNextPageId();
+      bpm->UnpinPage(page_id, false);
+      num_pages++;
+      num_sequential += next_page_id == page_id + 1 ? 1 : 0;
+      page_id = next_page_id;
+    }
+    ASSERT_GT(num_pages, 2 * DEFAULT_PAGE_RUN_SIZE);
+    // only the hops between two runs may jump
+    EXPECT_GE(num_sequential, num_pages - 1 - num_pages / DEFAULT_PAGE_RUN_SIZE);
+    unused += (DEFAULT_PAGE_RUN_SIZE - num_pages % DEFAULT_PAGE_RUN_SIZE) % DEFAULT_PAGE_RUN_SIZE;
+  }
+  // Scenario: the pages reserved but never used go back to the disk manager, exactly those.
+  ASSERT_GT(unused, 0);
+  uint32_t allocated = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData())->GetAllocatedPages();
+  delete heaps[0];
+  delete heaps[1];
+  EXPECT_EQ(allocated - unused, reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData())->GetAllocatedPages());
+  delete bpm;
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(TableHeapTest, FreeSpaceMapTest) {
+  const std::string db_name = "table_heap_fsm_test.db";
+  remove(db_name.c_str());
+  auto disk_mgr = new DiskManager(db_name);
+  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 512, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+  std::string name(500, 'x');
+  auto make_row = [&](int id) {
+    Fields fields{Field(TypeId::kTypeInt, id), Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), 500, true)};
+    return Row(fields);
+  };
+  const int row_nums = 200 * PAGE_SIZE / 4096;
+  std::vector<RowId> rids;
+  std::set<page_id_t> page_ids;
+  for (int i = 0; i < row_nums; i++) {
+    Row row = make_row(i);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    rids.push_back(row.GetRowId());
+    page_ids.insert(row.GetRowId().GetPageId());
+  }
+  page_id_t first_page_id = table_heap->GetFirstPageId();
+  page_id_t fsm_page_id = table_heap->GetFreeSpaceMapPageId();
+  ASSERT_NE(INVALID_PAGE_ID, fsm_page_id);
+
+  // Scenario: the space freed in a page in the middle of the chain is reused, once the room left in the last page,
+  // the better fit, is taken no new page is needed.
+  page_id_t freed_page_id = rids[row_nums / 2].GetPageId();
+  int num_freed = 0;
+  for (auto &rid : rids) {
+    if (rid.GetPageId() == freed_page_id) {
+      table_heap->ApplyDelete(rid, nullptr);
+      num_freed++;
+    }
+  }
+  ASSERT_GT(num_freed, 1);
+  int num_inserted = 0;
+  Row row;
+  do {
+    row = make_row(row_nums + num_inserted++);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    ASSERT_EQ(1, page_ids.count(row.GetRowId().GetPageId()));
+  } while (row.GetRowId().GetPageId() != freed_page_id);
+  delete table_heap;
+  delete bpm;
+  delete disk_mgr;
+
+  // Scenario: after a restart the map is read back, an insert neither walks the chain nor misses the freed space.
+  disk_mgr = new DiskManager(db_name);
+  bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  table_heap = TableHeap::Create(bpm, first_page_id, fsm_page_id, schema.get(), nullptr, nullptr);
+  row = make_row(row_nums + num_inserted++);
+  ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+  EXPECT_EQ(freed_page_id, row.GetRowId().GetPageId());
+  AccessStats *stats = table_heap->GetAccessStats();
+  auto fetches = [&]() { return stats->GetFetchHits() + stats->GetFetchMisses(); };
+  uint64_t fetched = fetches();
+  row = make_row(row_nums + num_inserted++);
+  ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+  EXPECT_LE(fetches() - fetched, 2);
+  size_t num_rows = 0;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    num_rows++;
+  }
+  EXPECT_EQ(row_nums - num_freed + num_inserted, num_rows);
+
+  // Scenario: cutting the chain frees the pages from the given one on disk, the page before it ends the chain and
+  // takes the next appended page.
+  page_id_t cut_page_id = rids[row_nums * 3 / 4].GetPageId();
+  table_heap->DeleteTable(cut_page_id);
+  EXPECT_TRUE(bpm->IsPageFree(cut_page_id));
+  num_rows = 0;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    ASSERT_LT(iter.GetRowId().GetPageId(), cut_page_id);
+    num_rows++;
+  }
+  EXPECT_GT(num_rows, 0);
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums / 2; i++) {
+    rows.push_back(make_row(i));
+  }
+  ASSERT_EQ(DB_SUCCESS, table_heap->InsertTuples(rows, nullptr));
+  size_t num_scanned = 0;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    num_scanned++;
+  }
+  EXPECT_EQ(num_rows + rows.size(), num_scanned);
+  // Scenario: deleting the whole table frees its pages and those of its map on disk.
+  table_heap->DeleteTable();
+  EXPECT_TRUE(bpm->IsPageFree(first_page_id));
+  EXPECT_TRUE(bpm->IsPageFree(fsm_page_id));
+  delete table_heap;
+  delete bpm;
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(TableHeapTest, FreeSpaceMapChainTest) {
+  const std::string db_name = "table_heap_fsm_chain_test.db";
+  remove(db_name.c_str());
+  auto disk_mgr = new DiskManager(db_name);
+  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  // more than half a page in values short enough to stay in the row
+  const uint32_t column_count = 8;
+  const uint32_t length = (TablePage::SIZE_MAX_ROW / 2 + 16) / column_count;
+  std::vector<Column *> columns;
+  for (uint32_t i = 0; i < column_count; i++) {
+    columns.push_back(new Column("name" + std::to_string(i), TypeId::kTypeChar, length, i, true, false));
+  }
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+  std::string name(length, 'y');
+  // Scenario: one row per page, the table outgrows its first map page and the map chains a second one.
+  const uint32_t row_nums = FreeSpaceMapPage::MAX_ENTRY_COUNT + 10;
+  for (uint32_t i = 0; i < row_nums; i++) {
+    Fields fields(column_count, Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), length, true));
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+  }
+  auto fsm_page = reinterpret_cast<FreeSpaceMapPage *>(bpm->FetchPage(table_heap->GetFreeSpaceMapPageId())->GetData());
+  EXPECT_TRUE(fsm_page->IsFull());
+  page_id_t next_fsm_page_id = fsm_page->GetNextPageId();
+  bpm->UnpinPage(table_heap->GetFreeSpaceMapPageId(), false);
+  ASSERT_NE(INVALID_PAGE_ID, next_fsm_page_id);
+  fsm_page = reinterpret_cast<FreeSpaceMapPage *>(bpm->FetchPage(next_fsm_page_id)->GetData());
+  EXPECT_EQ(row_nums - FreeSpaceMapPage::MAX_ENTRY_COUNT, fsm_page->GetEntryCount());
+  bpm->UnpinPage(next_fsm_page_id, false);
+  delete table_heap;
+  delete bpm;
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(TableHeapTest, InsertTuplesTest) {
+  const std::string db_name = "table_heap_batch_test.db";
+  remove(db_name.c_str());
+  auto disk_mgr = new DiskManager(db_name);
+  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+  std::string name(60, 'z');
+  const int row_nums = 1000 * PAGE_SIZE / 4096;
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), 60, true)};
+    rows.emplace_back(fields);
+  }
+  // Scenario: a batch fills every page before moving to the next one, each page is pinned about once.
+  AccessStats *stats = table_heap->GetAccessStats();
+  ASSERT_EQ(DB_SUCCESS, table_heap->InsertTuples(rows, nullptr));
+  std::set<page_id_t> page_ids;
+  for (auto &row : rows) {
+    page_ids.insert(row.GetRowId().GetPageId());
+  }
+  EXPECT_GT(page_ids.size(), 10);
+  // the new page, its predecessor and the map page for each page
+  EXPECT_LE(stats->GetFetchHits() + stats->GetFetchMisses(), 3 * page_ids.size() + 3);
+  for (int i = 0; i < row_nums; i++) {
+    Row row(rows[i].GetRowId());
+    ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(0)->CompareEquals(Field(TypeId::kTypeInt, i)));
+  }
+  // Scenario: a batch holding a row too large for a page inserts nothing, even with none of its values long enough
+  // for an overflow page.
+  const uint32_t length = CHAR_OVERFLOW_THRESHOLD;
+  const uint32_t column_count = PAGE_SIZE / length + 1;
+  std::string long_name(length, 'z');
+  std::vector<Column *> long_columns;
+  for (uint32_t i = 0; i < column_count; i++) {
+    long_columns.push_back(new Column("c" + std::to_string(i), TypeId::kTypeChar, length, i, true, false));
+  }
+  auto long_schema = std::make_shared<Schema>(long_columns);
+  TableHeap *long_heap = TableHeap::Create(bpm, long_schema.get(), nullptr, nullptr, nullptr);
+  Fields short_fields(column_count, Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), 60, true));
+  Fields long_fields(column_count, Field(TypeId::kTypeChar, const_cast<char *>(long_name.c_str()), length, true));
+  std::vector<Row> long_rows{Row(short_fields), Row(long_fields)};
+  EXPECT_EQ(DB_FAILED, long_heap->InsertTuples(long_rows, nullptr));
+  EXPECT_EQ(long_heap->End(), long_heap->Begin(nullptr));
+  delete long_heap;
+  delete table_heap;
+  delete bpm;
+  // Scenario: with every frame of the pool pinned the batch fails as such, and the table keeps only its earlier rows.
+  const size_t pool_size = 8;
+  bpm = new BufferPoolManager(pool_size, disk_mgr);
+  table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+  Row first(rows[0]);
+  ASSERT_TRUE(table_heap->InsertTuple(first, nullptr));
+  std::vector<page_id_t> pinned(pool_size);
+  for (auto &page_id : pinned) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+  }
+  std::vector<Row> batch(rows.begin(), rows.begin() + 10);
+  EXPECT_EQ(DB_BUFFER_POOL_FULL, table_heap->InsertTuples(batch, nullptr));
+  for (auto page_id : pinned) {
+    bpm->UnpinPage(page_id, false);
+  }
+  int count = 0;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    count++;
+  }
+  EXPECT_EQ(1, count);
+  delete table_heap;
+  delete bpm;
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(TableHeapTest, TableIteratorTest) {
+  const std::string db_name = "table_heap_iterator_test.db";
+  remove(db_name.c_str());
+  auto disk_mgr = new DiskManager(db_name);
+  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+  std::string name(60, 'i');
+  const int row_nums = 1000 * PAGE_SIZE / 4096;
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), 60, true)};
+    rows.emplace_back(fields);
+  }
+  ASSERT_EQ(DB_SUCCESS, table_heap->InsertTuples(rows, nullptr));
+  std::set<page_id_t> page_ids;
+  for (auto &row : rows) {
+    page_ids.insert(row.GetRowId().GetPageId());
+  }
+  ASSERT_GT(page_ids.size(), 10);
+  AccessStats *stats = table_heap->GetAccessStats();
+  auto fetches = [&]() { return stats->GetFetchHits() + stats->GetFetchMisses(); };
+
+  // Scenario: a scan which only looks at the rids pins each page once and nothing stays pinned after it.
+  uint64_t fetched = fetches();
+  int num_rows = 0;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    ASSERT_EQ(rows[num_rows++].GetRowId(), iter.GetRowId());
+  }
+  EXPECT_EQ(row_nums, num_rows);
+  EXPECT_EQ(page_ids.size(), fetches() - fetched);
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  // Scenario: the tuples are materialized on access, from the view of the pinned page.
+  num_rows = 0;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    RowView view = iter.GetRowView();
+    Row row;
+    view.Materialize(&row, schema.get());
+    ASSERT_EQ(iter->GetRowId(), row.GetRowId());
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(0)->CompareEquals(Field(TypeId::kTypeInt, num_rows)));
+    ASSERT_EQ(CmpBool::kTrue, iter->GetField(0)->CompareEquals(Field(TypeId::kTypeInt, num_rows)));
+    ASSERT_EQ(name, (*iter).GetField(1)->toString());
+    num_rows++;
+  }
+  EXPECT_EQ(row_nums, num_rows);
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  // Scenario: a copy keeps its own page pinned while the original moves on to other pages.
+  {
+    auto iter = table_heap->Begin(nullptr);
+    auto copy = iter++;
+    TableIterator assigned;
+    assigned = copy;
+    while (iter != table_heap->End() && iter.GetRowId().GetPageId() == copy.GetRowId().GetPageId()) {
+      ++iter;
+    }
+    ASSERT_NE(table_heap->End(), iter);
+    EXPECT_EQ(rows[0].GetRowId(), copy->GetRowId());
+    EXPECT_EQ(CmpBool::kTrue, assigned->GetField(0)->CompareEquals(Field(TypeId::kTypeInt, 0)));
+    TableIterator moved(std::move(iter));
+    EXPECT_EQ(table_heap->End(), iter);
+    EXPECT_NE(table_heap->End(), moved);
+    EXPECT_FALSE(bpm->CheckAllUnpinned());
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+  delete table_heap;
+  delete bpm;
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(TableHeapTest, PaxLayoutTest) {
+  const std::string db_name = "table_heap_pax_test.db";
+  remove(db_name.c_str());
+  auto disk_mgr = new DiskManager(db_name);
+  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  uint32_t capacity = PaxPage::ComputeCapacity(schema.get());
+  ASSERT_GT(capacity, 1);
+  TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr, TableLayout::kPax);
+  ASSERT_EQ(TableLayout::kPax, table_heap->GetLayout());
+  auto make_row = [&](int id) {
+    std::string name = "name-" + std::to_string(id);
+    Fields fields{Field(TypeId::kTypeInt, id), Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()),
+                                                     static_cast<uint32_t>(name.size()), true),
+                  id % 7 == 0 ? Field(TypeId::kTypeFloat) : Field(TypeId::kTypeFloat, id * 0.5f)};
+    return Row(fields);
+  };
+  auto check_row = [&](const Row &row, int id) {
+    Row expected = make_row(id);
+    for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+      if (expected.GetField(i)->IsNull()) {
+        ASSERT_TRUE(row.GetField(i)->IsNull());
+      } else {
+        ASSERT_EQ(CmpBool::kTrue, row.GetField(i)->CompareEquals(*expected.GetField(i)));
+      }
+    }
+  };
+
+  // Scenario: a page holds exactly `capacity` rows, the rows read back whole.
+  const int row_nums = static_cast<int>(capacity) * 3 + 5;
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    rows.push_back(make_row(i));
+  }
+  ASSERT_EQ(DB_SUCCESS, table_heap->InsertTuples(rows, nullptr));
+  std::unordered_map<page_id_t, uint32_t> rows_per_page;
+  for (auto &row : rows) {
+    rows_per_page[row.GetRowId().GetPageId()]++;
+  }
+  ASSERT_EQ(4, rows_per_page.size());
+  for (auto &page_rows : rows_per_page) {
+    EXPECT_TRUE(page_rows.second == capacity || page_rows.second == 5);
+  }
+  for (int i = 0; i < row_nums; i++) {
+    Row row(rows[i].GetRowId());
+    ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+    check_row(row, i);
+  }
+  // Scenario: a row read into an arena takes its fields and their chars straight from it.
+  MemoryArena arena;
+  for (int i : {1, 7}) {
+    Row arena_row(&arena);
+    arena_row.SetRowId(rows[i].GetRowId());
+    ASSERT_TRUE(table_heap->GetTuple(&arena_row, nullptr));
+    check_row(arena_row, i);
+  }
+  // three fields for each row, and the chars of the names
+  EXPECT_EQ(8, arena.GetStats().allocations_);
+
+  // Scenario: a scan only reads the columns asked for, the others are NULL.
+  std::vector<uint32_t> scan_columns{0, 2};
+  int num_rows = 0;
+  Row scan_row;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    ASSERT_EQ(nullptr, iter.GetRowView().GetData());
+    iter.GetRowView().Materialize(&scan_row, schema.get(), &scan_columns);
+    ASSERT_EQ(rows[num_rows].GetRowId(), scan_row.GetRowId());
+    ASSERT_EQ(CmpBool::kTrue, scan_row.GetField(0)->CompareEquals(Field(TypeId::kTypeInt, num_rows)));
+    ASSERT_TRUE(scan_row.GetField(1)->IsNull());
+    ASSERT_EQ(num_rows % 7 == 0, scan_row.GetField(2)->IsNull());
+    check_row(*iter, num_rows);
+    num_rows++;
+  }
+  EXPECT_EQ(row_nums, num_rows);
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  // Scenario: updates are done in place, a value wider than its column is refused.
+  Row updated = make_row(row_nums + 1);
+  ASSERT_TRUE(table_heap->UpdateTuple(updated, rows[1].GetRowId(), nullptr));
+  Row row(rows[1].GetRowId());
+  ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+  check_row(row, row_nums + 1);
+  std::string long_name(33, 'x');
+  Fields long_fields{Field(TypeId::kTypeInt, 0),
+                     Field(TypeId::kTypeChar, const_cast<char *>(long_name.c_str()), 33, true),
+                     Field(TypeId::kTypeFloat, 0.f)};
+  Row long_row(long_fields);
+  EXPECT_FALSE(table_heap->UpdateTuple(long_row, rows[2].GetRowId(), nullptr));
+  EXPECT_FALSE(table_heap->InsertTuple(long_row, nullptr));
+
+  // Scenario: deleted rows disappear from scans, a rolled back delete brings the row back, freed slots are reused.
+  ASSERT_TRUE(table_heap->MarkDelete(rows[3].GetRowId(), nullptr));
+  ASSERT_TRUE(table_heap->MarkDelete(rows[4].GetRowId(), nullptr));
+  row.SetRowId(rows[3].GetRowId());
+  EXPECT_FALSE(table_heap->GetTuple(&row, nullptr));
+  table_heap->RollbackDelete(rows[3].GetRowId(), nullptr);
+  table_heap->ApplyDelete(rows[4].GetRowId(), nullptr);
+  num_rows = 0;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    ASSERT_FALSE(rows[4].GetRowId() == iter.GetRowId());
+    num_rows++;
+  }
+  EXPECT_EQ(row_nums - 1, num_rows);
+  Row reused = make_row(4);
+  ASSERT_TRUE(table_heap->InsertTuple(reused, nullptr));
+  EXPECT_EQ(rows[4].GetRowId(), reused.GetRowId());
+  page_id_t first_page_id = table_heap->GetFirstPageId();
+  page_id_t fsm_page_id = table_heap->GetFreeSpaceMapPageId();
+  delete table_heap;
+  delete bpm;
+  delete disk_mgr;
+
+  // Scenario: the layout is given back when the table is opened again.
+  disk_mgr = new DiskManager(db_name);
+  bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  table_heap = TableHeap::Create(bpm, first_page_id, fsm_page_id, schema.get(), nullptr, nullptr, TableLayout::kPax);
+  row.SetRowId(rows[row_nums - 1].GetRowId());
+  ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+  check_row(row, row_nums - 1);
+  delete table_heap;
+  delete bpm;
+  delete disk_mgr;
+  remove(db_name.c_str());
+
+  // Scenario: a schema whose row does not fit a page cannot use the layout.
+  std::vector<Column *> wide_columns = {new Column("text", TypeId::kTypeChar, PAGE_SIZE, 0, true, false)};
+  Schema wide_schema(wide_columns);
+  EXPECT_EQ(0, PaxPage::ComputeCapacity(&wide_schema));
+}
+
+TEST(TableHeapTest, OverflowTest) {
+  const std::string db_name = "table_heap_overflow_test.db";
+  remove(db_name.c_str());
+  auto disk_mgr = new DiskManager(db_name);
+  auto bpm = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("doc", TypeId::kTypeChar, 3 * PAGE_SIZE, 1, true, false),
+                                   new Column("tag", TypeId::kTypeChar, 16, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm, schema.get(), nullptr, nullptr, nullptr);
+  auto make_row = [&](int id, const std::string &doc) {
+    std::string tag = "tag-" + std::to_string(id);
+    Fields fields{Field(TypeId::kTypeInt, id),
+                  Field(TypeId::kTypeChar, const_cast<char *>(doc.c_str()), static_cast<uint32_t>(doc.size()), true),
+                  Field(TypeId::kTypeChar, const_cast<char *>(tag.c_str()), static_cast<uint32_t>(tag.size()), true)};
+    return Row(fields);
+  };
+  // the first overflow page of the doc of a tuple as it is stored, INVALID_PAGE_ID if the doc is inline
+  auto overflow_page_of = [&](const RowId &rid) {
+    for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+      if (iter.GetRowId() == rid) {
+        RowView view = iter.GetRowView();
+        Row stored;
+        stored.DeserializeFrom(const_cast<char *>(view.GetData()), schema.get());
+        return stored.GetField(1)->GetOverflowPageId();
+      }
+    }
+    return INVALID_PAGE_ID;
+  };
+
+  // Scenario: long values move to overflow pages and are read back whole, the short ones stay in the row.
+  std::vector<std::string> docs = {std::string(10, 'a'), std::string(CHAR_OVERFLOW_THRESHOLD + 1, 'b'),
+                                   std::string(2 * PAGE_SIZE + 5, 'c')};
+  std::vector<RowId> rids;
+  for (size_t i = 0; i < docs.size(); i++) {
+    Row row = make_row(i, docs[i]);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    ASSERT_EQ(docs[i].size(), row.GetField(1)->GetLength());
+    rids.push_back(row.GetRowId());
+  }
+  EXPECT_EQ(INVALID_PAGE_ID, overflow_page_of(rids[0]));
+  EXPECT_NE(INVALID_PAGE_ID, overflow_page_of(rids[1]));
+  for (size_t i = 0; i < docs.size(); i++) {
+    Row row(rids[i]);
+    ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+    EXPECT_EQ(docs[i], row.GetField(1)->toString());
+  }
+
+  // Scenario: rows with long values stay dense, a batch of them shares few pages.
+  std::string long_doc(PAGE_SIZE / 2, 'd');
+  std::vector<Row> rows;
+  for (int i = 0; i < 100; i++) {
+    rows.push_back(make_row(100 + i, long_doc));
+  }
+  ASSERT_EQ(DB_SUCCESS, table_heap->InsertTuples(rows, nullptr));
+  std::set<page_id_t> page_ids;
+  for (auto &row : rows) {
+    page_ids.insert(row.GetRowId().GetPageId());
+  }
+  EXPECT_LE(page_ids.size(), 2);
+
+  // Scenario: a scan only fetches the long values of the columns it reads.
+  AccessStats *stats = table_heap->GetAccessStats();
+  auto fetches = [&]() { return stats->GetFetchHits() + stats->GetFetchMisses(); };
+  std::vector<uint32_t> scan_columns{0, 2};
+  uint64_t fetched = fetches();
+  size_t num_rows = 0;
+  Row scan_row;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    iter.GetRowView().Materialize(&scan_row, schema.get(), &scan_columns);
+    ASSERT_TRUE(scan_row.GetField(1)->IsNull());
+    ASSERT_FALSE(scan_row.GetField(2)->IsNull());
+    num_rows++;
+  }
+  EXPECT_EQ(docs.size() + rows.size(), num_rows);
+  EXPECT_LE(fetches() - fetched, page_ids.size() + 1);
+  num_rows = 0;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); ++iter) {
+    ASSERT_EQ(num_rows < docs.size() ? docs[num_rows] : long_doc, iter->GetField(1)->toString());
+    num_rows++;
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  // Scenario: an update replaces a long value by another one, or by a short one kept in the row. The overflow pages
+  // of the old values are freed on disk.
+  page_id_t old_overflow_page_id = overflow_page_of(rids[2]);
+  ASSERT_NE(INVALID_PAGE_ID, old_overflow_page_id);
+  Row updated = make_row(2, std::string(PAGE_SIZE, 'e'));
+  ASSERT_TRUE(table_heap->UpdateTuple(updated, rids[2], nullptr));
+  EXPECT_TRUE(bpm->IsPageFree(old_overflow_page_id));
+  Row row(rids[2]);
+  ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+  EXPECT_EQ(std::string(PAGE_SIZE, 'e'), row.GetField(1)->toString());
+  updated = make_row(2, "short");
+  ASSERT_TRUE(table_heap->UpdateTuple(updated, rids[2], nullptr));
+  EXPECT_EQ(INVALID_PAGE_ID, overflow_page_of(rids[2]));
+  Row short_row(rids[2]);
+  ASSERT_TRUE(table_heap->GetTuple(&short_row, nullptr));
+  EXPECT_EQ("short", short_row.GetField(1)->toString());
+  page_id_t deleted_overflow_page_id = overflow_page_of(rids[1]);
+  ASSERT_TRUE(table_heap->MarkDelete(rids[1], nullptr));
+  table_heap->ApplyDelete(rids[1], nullptr);
+  Row deleted(rids[1]);
+  EXPECT_FALSE(table_heap->GetTuple(&deleted, nullptr));
+  EXPECT_TRUE(bpm->IsPageFree(deleted_overflow_page_id));
+  // Scenario: a failed update leaves no page pinned, and the overflow pages written for its long value are freed.
+  auto allocated_pages = [&]() {
+    return reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData())->GetAllocatedPages();
+  };
+  uint32_t allocated = allocated_pages();
+  Row missing = make_row(3, std::string(PAGE_SIZE, 'f'));
+  EXPECT_FALSE(table_heap->UpdateTuple(missing, RowId(rids[0].GetPageId(), 1000), nullptr));
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+  EXPECT_EQ(allocated, allocated_pages());
+  table_heap->DeleteTable();
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+  delete table_heap;
+  delete bpm;
+  delete disk_mgr;
+  remove(db_name.c_str());
+}